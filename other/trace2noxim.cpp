@@ -0,0 +1,136 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../src/TrafficTrace.h"
+
+using namespace std;
+
+struct TextPacket {
+    long cycle;
+    int src, dst, size, traffic_class;
+    long dependency;	// Line of the packet it depends on, -1 if none
+    long line;		// Packet index in the text trace
+};
+
+bool BySourceAndCycle(const TextPacket & a, const TextPacket & b)
+{
+    if (a.src != b.src)
+        return a.src < b.src;
+    if (a.cycle != b.cycle)
+        return a.cycle < b.cycle;
+    return a.line < b.line;
+}
+
+void HelpMessage(char *fname)
+{
+    cout << "Usage: " << fname << " text_trace binary_trace" << endl
+         << endl
+         << "Converts a text trace to the binary trace replayed by noxim (-traffic trace)." << endl
+         << "Each line of the text trace describes a packet:" << endl
+         << "\tcycle src dst size [class [dependency]]" << endl
+         << "where \"dependency\" is the index (from 0) of the packet that must be received" << endl
+         << "before this one is sent, -1 if none. Lines starting with % are comments." << endl
+         << endl
+         << "Example:" << endl
+         << fname << " trace.txt trace.bin" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        HelpMessage(argv[0]);
+        return -1;
+    }
+
+    ifstream fin(argv[1]);
+    if (!fin) {
+        cerr << "Cannot open " << argv[1] << endl;
+        return -1;
+    }
+
+    vector<TextPacket> packets;
+    int cores = 0;
+    string line;
+
+    while (getline(fin, line)) {
+        if (line.empty() || line[0] == '%')
+            continue;
+
+        istringstream iss(line);
+        TextPacket p;
+        p.traffic_class = 0;
+        p.dependency = -1;
+
+        if (!(iss >> p.cycle >> p.src >> p.dst >> p.size)) {
+            cerr << "Bad line: " << line << endl;
+            return -1;
+        }
+        iss >> p.traffic_class >> p.dependency;
+
+        if (p.cycle < 0 || p.src < 0 || p.dst < 0 || p.dst > 0xFFFF ||
+            p.size < 1 || p.size > 0xFF || p.traffic_class < 0 || p.traffic_class > 0xFF) {
+            cerr << "Out of range values: " << line << endl;
+            return -1;
+        }
+
+        p.line = packets.size();
+        packets.push_back(p);
+        cores = max(cores, max(p.src, p.dst) + 1);
+    }
+
+    for (unsigned int i = 0; i < packets.size(); i++)
+        if (packets[i].dependency >= (long) packets.size()) {
+            cerr << "Packet " << i << " depends on a missing packet" << endl;
+            return -1;
+        }
+
+    // Packets of each source are contiguous in the binary trace, the
+    // dependencies follow them to their new index
+    sort(packets.begin(), packets.end(), BySourceAndCycle);
+
+    vector<long> position(packets.size());
+    for (unsigned int i = 0; i < packets.size(); i++)
+        position[packets[i].line] = i;
+
+    TraceHeader header;
+    memcpy(header.magic, TRACE_MAGIC, 4);
+    header.version = TRACE_VERSION;
+    header.cores = cores;
+    header.reserved = 0;
+    header.packets = packets.size();
+
+    vector<uint64_t> first(cores + 1, 0);
+    for (unsigned int i = 0; i < packets.size(); i++)
+        first[packets[i].src + 1]++;
+    for (int c = 0; c < cores; c++)
+        first[c + 1] += first[c];
+
+    ofstream fout(argv[2], ios::binary);
+    if (!fout) {
+        cerr << "Cannot create " << argv[2] << endl;
+        return -1;
+    }
+
+    fout.write((const char *) &header, sizeof(header));
+    fout.write((const char *) &first[0], first.size() * sizeof(uint64_t));
+
+    for (unsigned int i = 0; i < packets.size(); i++) {
+        TraceRecord r;
+        r.cycle = packets[i].cycle;
+        r.dependency = packets[i].dependency < 0 ? TRACE_NO_DEPENDENCY : position[packets[i].dependency];
+        r.dst = packets[i].dst;
+        r.size = packets[i].size;
+        r.traffic_class = packets[i].traffic_class;
+        fout.write((const char *) &r, sizeof(r));
+    }
+
+    cout << packets.size() << " packets of " << cores << " cores written to " << argv[2] << endl;
+
+    return 0;
+}
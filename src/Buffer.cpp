@@ -11,8 +11,68 @@
 #include "Buffer.h"
 #include "Utils.h"
 
+BufferPool::BufferPool()
+{
+  shared = false;
+  size = 0;
+  reserved = 0;
+  for (int vc = 0; vc < MAX_VIRTUAL_CHANNELS; vc++)
+    occupancy[vc] = 0;
+}
+
+void BufferPool::configure(const bool damq)
+{
+  shared = damq;
+  if (damq) {
+    size = GlobalParams::damq_pool_size;
+    if (size == 0)
+      size = GlobalParams::n_virtual_channels * GlobalParams::buffer_depth;
+    reserved = GlobalParams::damq_reserved;
+  } else {
+    size = GlobalParams::n_virtual_channels * GlobalParams::buffer_depth;
+    reserved = GlobalParams::buffer_depth;
+  }
+}
+
+int BufferPool::freeSlots(const int * occupancy, const int vc) const
+{
+  int shared_free = size - GlobalParams::n_virtual_channels * reserved;
+
+  for (int v = 0; v < GlobalParams::n_virtual_channels; v++)
+    shared_free -= max(occupancy[v] - reserved, 0);
+
+  return max(reserved - occupancy[vc], 0) + shared_free;
+}
+
+int BufferPool::maxSlots() const
+{
+  return size - (GlobalParams::n_virtual_channels - 1) * reserved;
+}
+
+int BufferPool::storageBits(const int item_size) const
+{
+  if (!shared)
+    return size * item_size;
+
+  return size * (item_size + pointerBits());
+}
+
+int BufferPool::pointerBits() const
+{
+  if (!shared)
+    return 0;
+
+  int bits = 0;
+  while ((1 << bits) < size)
+    bits++;
+
+  return bits;
+}
+
 Buffer::Buffer()
 {
+  pool = NULL;
+  pool_vc = 0;
   SetMaxBufferSize(GlobalParams::buffer_depth);
   max_occupancy = 0;
   hold_time = 0.0;
@@ -38,6 +98,13 @@ string Buffer::getLabel() const
     return label;
 }
 
+void Buffer::setPool(BufferPool * _pool, const int vc)
+{
+    pool = _pool;
+    pool_vc = vc;
+    max_buffer_size = pool->maxSlots();
+}
+
 void Buffer::Print()
 {
     queue<Flit> m = buffer;
@@ -141,6 +208,9 @@ unsigned int Buffer::GetMaxBufferSize() const
 
 bool Buffer::IsFull() const
 {
+  if (pool)
+    return pool->freeSlots(pool->occupancy, pool_vc) == 0;
+
   return buffer.size() == max_buffer_size;
 }
 
@@ -165,8 +235,11 @@ void Buffer::Push(const Flit & flit)
 
   if (IsFull())
     Drop(flit);
-  else
+  else {
     buffer.push(flit);
+    if (pool)
+      pool->occupancy[pool_vc]++;
+  }
   
   UpdateMeanOccupancy();
 
@@ -185,6 +258,8 @@ Flit Buffer::Pop()
   else {
     f = buffer.front();
     buffer.pop();
+    if (pool)
+      pool->occupancy[pool_vc]--;
   }
 
   UpdateMeanOccupancy();
@@ -211,6 +286,9 @@ unsigned int Buffer::Size() const
 
 unsigned int Buffer::getCurrentFreeSlots() const
 {
+  if (pool)
+    return pool->freeSlots(pool->occupancy, pool_vc);
+
   return (GetMaxBufferSize() - Size());
 }
 
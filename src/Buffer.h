@@ -16,6 +16,42 @@
 #include "DataStructs.h"
 using namespace std;
 
+// Organization of the slots of an input port. Statically partitioned
+// buffers give buffer_depth slots to each VC. DAMQ buffers share a pool
+// of slots, kept as a linked list for each VC: every VC owns a few
+// reserved slots and takes the others while they are free
+class BufferPool {
+
+  public:
+
+    BufferPool();
+
+    void configure(const bool damq);
+
+    bool isShared() const { return shared; }
+    int getSize() const { return size; }
+
+    // Slots left to VC vc, given the flits held by each VC
+    int freeSlots(const int * occupancy, const int vc) const;
+
+    // Most flits a single VC can hold
+    int maxSlots() const;
+
+    // Bits needed to store the pool, next slot pointers included
+    int storageBits(const int item_size) const;
+
+    // Width of the next slot pointers, 0 for private buffers
+    int pointerBits() const;
+
+    int occupancy[MAX_VIRTUAL_CHANNELS];	// Flits held by each VC of the port
+
+  private:
+
+    bool shared;
+    int size;			// Slots of the port
+    int reserved;		// Slots owned by each VC
+};
+
 class Buffer {
 
   public:
@@ -59,8 +95,15 @@ class Buffer {
     void setLabel(string);
     string getLabel() const;
 
+    // Makes the buffer the VC vc of a DAMQ port, whose slots are
+    // accounted in pool
+    void setPool(BufferPool * pool, const int vc);
+
   private:
 
+    BufferPool * pool;
+    int pool_vc;
+
     bool true_buffer;
     bool deadlock_detected;
 
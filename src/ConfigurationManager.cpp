@@ -9,6 +9,8 @@
  */
 
 #include "ConfigurationManager.h"
+#include "topologies/Topologies.h"
+#include "Utils.h"
 #include <systemc.h> //Included for the function time() 
 
 YAML::Node config;
@@ -52,10 +54,19 @@ void loadConfiguration() {
     GlobalParams::topology = readParam<string>(config, "topology", TOPOLOGY_MESH);
 
     //Mesh network params
-    if (GlobalParams::topology == TOPOLOGY_MESH) {
+    if (isMeshTopology()) {
         GlobalParams::mesh_dim_x = readParam<int>(config, "mesh_dim_x");
         GlobalParams::mesh_dim_y = readParam<int>(config, "mesh_dim_y");
     }
+    GlobalParams::mesh_dim_z = readParam<int>(config, "mesh_dim_z", 1);
+    GlobalParams::concentration = readParam<int>(config, "concentration", 1);
+    GlobalParams::express_interval = readParam<int>(config, "express_interval", 0);
+    GlobalParams::chiplet_dim_x = readParam<int>(config, "chiplet_dim_x", 0);
+    GlobalParams::chiplet_dim_y = readParam<int>(config, "chiplet_dim_y", 0);
+    GlobalParams::interposer_links = readParam<int>(config, "interposer_links", 1);
+    GlobalParams::interposer_link_length = readParam<double>(config, "interposer_link_length", 2.0);
+    GlobalParams::interposer_link_latency = readParam<int>(config, "interposer_link_latency", 4);
+    GlobalParams::interposer_link_width = readParam<int>(config, "interposer_link_width", 0);
 	//Delta network params
     if (GlobalParams::topology == TOPOLOGY_BASELINE  ||
         GlobalParams::topology == TOPOLOGY_BUTTERFLY ||
@@ -64,20 +75,70 @@ void loadConfiguration() {
         //GlobalParams::mesh_dim_y = readParam<int>(config, "mesh_dim_y");
         GlobalParams::n_delta_tiles = readParam<int>(config, "n_delta_tiles");
     }
+    GlobalParams::delta_radix = readParam<int>(config, "delta_radix", 2);
+    GlobalParams::topology_filename = readParam<string>(config, "topology_filename", "");
 
     GlobalParams::r2r_link_length = readParam<double>(config, "r2r_link_length");
+    GlobalParams::r2r_link_latency = readParam<int>(config, "r2r_link_latency", 1);
+    GlobalParams::link_mm_per_cycle = readParam<double>(config, "link_mm_per_cycle", 0);
+    GlobalParams::vertical_link_length = readParam<double>(config, "vertical_link_length", 0.05);
+    GlobalParams::vertical_link_latency = readParam<int>(config, "vertical_link_latency", 1);
     GlobalParams::r2h_link_length = readParam<double>(config, "r2h_link_length");
     GlobalParams::buffer_depth = readParam<int>(config, "buffer_depth");
+    GlobalParams::flow_control = readParam<string>(config, "flow_control", FLOW_CONTROL_ABP);
+    GlobalParams::buffer_organization = readParam<string>(config, "buffer_organization", BUFFER_ORGANIZATION_PRIVATE);
+    GlobalParams::damq_pool_size = readParam<int>(config, "damq_pool_size", 0);
+    GlobalParams::damq_reserved = readParam<int>(config, "damq_reserved", 1);
+    GlobalParams::router_architecture = readParam<string>(config, "router_architecture", ROUTER_BUFFERED);
+    GlobalParams::deflection_priority = readParam<string>(config, "deflection_priority", DEFLECTION_OLDEST_FIRST);
+    GlobalParams::golden_epoch = readParam<int>(config, "golden_epoch", 256);
+    GlobalParams::deadlock_check_period = readParam<int>(config, "deadlock_check_period", 1000);
+    GlobalParams::power_gating = readParam<string>(config, "power_gating", POWER_GATING_NONE);
+    GlobalParams::power_gating_timeout = readParam<int>(config, "power_gating_timeout", 32);
+    GlobalParams::power_gating_wakeup = readParam<int>(config, "power_gating_wakeup", 8);
+    GlobalParams::power_gating_wakeup_energy = readParam<double>(config, "power_gating_wakeup_energy", 2e-10);
+    GlobalParams::clock_domains = readParam<string>(config, "clock_domains", CLOCK_DOMAINS_NONE);
+    GlobalParams::clock_region_size = readParam<int>(config, "clock_region_size", 4);
+    GlobalParams::cdc_sync_cycles = readParam<int>(config, "cdc_sync_cycles", 2);
+    GlobalParams::dvfs_levels = readParam<string>(config, "dvfs_levels", "1:1,0.75:0.9,0.5:0.8");
+    GlobalParams::dvfs_policy = readParam<string>(config, "dvfs_policy", DVFS_STATIC);
+    GlobalParams::dvfs_initial_level = readParam<int>(config, "dvfs_initial_level", 0);
+    GlobalParams::dvfs_period = readParam<int>(config, "dvfs_period", 1000);
+    GlobalParams::dvfs_up_threshold = readParam<double>(config, "dvfs_up_threshold", 0.6);
+    GlobalParams::dvfs_down_threshold = readParam<double>(config, "dvfs_down_threshold", 0.3);
+    GlobalParams::router_pipeline = readParam<string>(config, "router_pipeline", "RC+VA+SA+ST");
+    GlobalParams::lookahead_routing = readParam<bool>(config, "lookahead_routing", false);
+    GlobalParams::speculative_allocation = readParam<bool>(config, "speculative_allocation", false);
     GlobalParams::flit_size = readParam<int>(config, "flit_size");
     GlobalParams::min_packet_size = readParam<int>(config, "min_packet_size");
     GlobalParams::max_packet_size = readParam<int>(config, "max_packet_size");
     GlobalParams::routing_algorithm = readParam<string>(config, "routing_algorithm");
     GlobalParams::routing_table_filename = readParam<string>(config, "routing_table_filename"); 
     GlobalParams::selection_strategy = readParam<string>(config, "selection_strategy");
+    GlobalParams::switch_allocator = readParam<string>(config, "switch_allocator", "RANDOM");
+    GlobalParams::vc_allocation = readParam<string>(config, "vc_allocation", VC_ALLOCATION_STATIC);
+    GlobalParams::traffic_class_vcs = readParam<string>(config, "traffic_class_vcs", "");
     GlobalParams::packet_injection_rate = readParam<double>(config, "packet_injection_rate");
     GlobalParams::probability_of_retransmission = readParam<double>(config, "probability_of_retransmission");
+    GlobalParams::source_queue_size = readParam<int>(config, "source_queue_size", 0);
+    GlobalParams::source_queue_vc_size = readParam<int>(config, "source_queue_vc_size", 0);
+    GlobalParams::source_queue_policy = readParam<string>(config, "source_queue_policy", SOURCE_QUEUE_STALL);
+    GlobalParams::multicast_rate = readParam<double>(config, "multicast_rate", 0.0);
+    GlobalParams::multicast_destinations = readParam<int>(config, "multicast_destinations", 0);
+    GlobalParams::multicast_replication = readParam<string>(config, "multicast_replication", MULTICAST_ROUTER);
+    GlobalParams::request_reply = readParam<bool>(config, "request_reply", false);
+    GlobalParams::reply_packet_size = readParam<int>(config, "reply_packet_size", 8);
+    GlobalParams::reply_service_time = readParam<int>(config, "reply_service_time", 10);
+    GlobalParams::max_outstanding_requests = readParam<int>(config, "max_outstanding_requests", 8);
+    GlobalParams::memory_controllers = readParam<string>(config, "memory_controllers", "");
+    GlobalParams::memory_banks = readParam<int>(config, "memory_banks", 8);
+    GlobalParams::memory_latency = readParam<int>(config, "memory_latency", 20);
+    GlobalParams::memory_bandwidth = readParam<double>(config, "memory_bandwidth", 1.0);
+    GlobalParams::memory_traffic_ratio = readParam<double>(config, "memory_traffic_ratio", 1.0);
     GlobalParams::traffic_distribution = readParam<string>(config, "traffic_distribution");
     GlobalParams::traffic_table_filename = readParam<string>(config, "traffic_table_filename");
+    GlobalParams::traffic_trace_filename = readParam<string>(config, "traffic_trace_filename", "");
+    GlobalParams::trace_dependencies = readParam<bool>(config, "trace_dependencies", true);
     GlobalParams::clock_period_ps = readParam<int>(config, "clock_period_ps");
     GlobalParams::simulation_time = readParam<int>(config, "simulation_time");
     GlobalParams::n_virtual_channels = readParam<int>(config, "n_virtual_channels");
@@ -197,10 +258,52 @@ void showHelp(char selfname[])
          << "\t-dimx N\t\t\tSet the mesh X dimension" << endl
          << "\t-dimy N\t\t\tSet the mesh Y dimension" << endl
          << "\t-buffer N\t\tSet the depth of router input buffers [flits]" << endl
+         << "\t-buffers TYPE\t\tSet the organization of router input buffers to one of the following:" << endl
+         << "\t\tPRIVATE\t\tEach VC has its own buffer of -buffer slots (default)" << endl
+         << "\t\tDAMQ\t\tThe VCs of a port share a pool of slots (dynamically allocated multi-queue)" << endl
+         << "\t-damq_size N\t\tSet the slots of DAMQ pools (default 0, i.e. vc x buffer)" << endl
+         << "\t-damq_reserved N\tSet the slots of DAMQ pools reserved to each VC (default 1)" << endl
+         << "\t-router TYPE\t\tSet the router architecture to one of the following:" << endl
+         << "\t\tBUFFERED\tInput buffered, wormhole switching (default)" << endl
+         << "\t\tDEFLECTION\tBufferless, flits losing arbitration are deflected" << endl
+         << "\t-deflection_priority TYPE\tSet the arbitration of deflection routers to one of the following:" << endl
+         << "\t\tOLDEST_FIRST\tOlder flits first (default)" << endl
+         << "\t\tGOLDEN\t\tFlits of the golden packets first, random order for the others" << endl
+         << "\t-golden_epoch N\t\tSet the cycles each source stays golden (default 256)" << endl
+         << "\t-deadlock_check N\tLook for deadlocks every N cycles, 0 to disable (default 1000)" << endl
+         << "\t-gating TYPE\t\tSet the power gating of idle routers to one of the following:" << endl
+         << "\t\tNONE\t\tRouters are always on (default)" << endl
+         << "\t\tTIMEOUT\t\tRouters are gated after -gating_timeout idle cycles" << endl
+         << "\t\tBREAK_EVEN\tRouters are gated when their predicted idle time exceeds the break-even time" << endl
+         << "\t-gating_timeout N\tSet the idle cycles before gating a router (default 32)" << endl
+         << "\t-gating_wakeup N\tSet the cycles a gated router takes to wake up (default 8)" << endl
+         << "\t-gating_wakeup_energy E\tSet the energy (J) of a router wake-up (default 2e-10)" << endl
+         << "\t-clock_domains TYPE\tSet the clock domains of the routers to one of the following:" << endl
+         << "\t\tNONE\t\tA single clock (default)" << endl
+         << "\t\tROUTER\t\tA clock domain for each router" << endl
+         << "\t\tREGION\t\tA clock domain for each square region of -region_size routers per side" << endl
+         << "\t-region_size N\t\tSet the routers per side of clock regions (default 4)" << endl
+         << "\t-cdc_sync N\t\tSet the cycles taken by flits to cross clock domains (default 2)" << endl
+         << "\t-dvfs_levels LIST\tSet the DVFS levels, LIST gives frequency:voltage pairs relative to the nominal ones separated by ','" << endl
+         << "\t-dvfs TYPE\t\tSet the DVFS policy to one of the following:" << endl
+         << "\t\tSTATIC\t\tClock domains keep the initial level (default)" << endl
+         << "\t\tUTILIZATION\tClock domains change level according to their utilization" << endl
+         << "\t-dvfs_level N\t\tSet the initial DVFS level (default 0)" << endl
+         << "\t-dvfs_period N\t\tSet the cycles between DVFS decisions (default 1000)" << endl
+         << "\t-dvfs_thresholds U D\tSet the utilization above (below) which domains speed up (slow down) (default 0.6 0.3)" << endl
+         << "\t-fc TYPE\t\tSet the link flow control to one of the following:" << endl
+         << "\t\tABP\t\tAlternating bit protocol, one flit in flight per link (default)" << endl
+         << "\t\tCREDIT\t\tCredit-based, one flit per cycle while the downstream buffer has room" << endl
+         << "\t-link_latency N\t\tSet the latency of router to router links [cycles] (default 1)" << endl
+         << "\t-mm_per_cycle D\t\tDerive the latency of links from their length, D mm being covered in a cycle" << endl
          << "\t-buffer_tt N\t\tSet the depth of hub buffers to tile [flits]" << endl
          << "\t-buffer_ft N\t\tSet the depth of hub buffers to tile [flits]" << endl
          << "\t-buffer_antenna N\tSet the depth of hub antenna buffers (RX/TX) [flits]" << endl
 	 << "\t-vc N\t\t\tNumber of virtual channels" << endl
+         << "\t-vca TYPE\t\tSet the VC allocation to one of the following:" << endl
+         << "\t\tSTATIC\t\tPackets keep the VC chosen at injection (default)" << endl
+         << "\t\tDYNAMIC\t\tRouters assign a free output VC to packets at each hop" << endl
+         << "\t-class_vcs LIST\t\tSplit the VCs among traffic classes, LIST gives the VCs of each class separated by ','" << endl
          << "\t-winoc\t\t\tEnable radio hub wireless transmission" << endl
          << "\t-winoc_dst_hops\t\t\tMax number of hops between target RadioHub and destination node" << endl
          << "\t-wirxsleep\t\tEnable radio hub wireless power manager" << endl
@@ -208,21 +311,49 @@ void showHelp(char selfname[])
          << "\t-flit N\t\t\tSet the flit size [bit]" << endl
          << "\t-topology TYPE\t\tSet the topology to one of the following:" << endl
          << "\t\tMESH\t\t2D Mesh" << endl
-         << "\t\tBUTTERFLY\tDelta network Butterfly (radix 2)" << endl
+         << "\t\tTORUS\t\t2D Torus (mesh with wraparound links)" << endl
+         << "\t\tFOLDED_TORUS\t2D Folded Torus (equal length links)" << endl
+         << "\t\tCMESH\t\t2D Concentrated Mesh (see -concentration)" << endl
+         << "\t\tMESH3D\t\t3D Mesh of dimz layers (see -dimz)" << endl
+         << "\t\tCHIPLET\t\tMeshes connected by interposer links (see -chiplet)" << endl
+         << "\t\tBUTTERFLY\tDelta network Butterfly (k-ary n-fly, see -dradix)" << endl
          << "\t\tBASELINE\tDelta network Baseline" << endl
          << "\t\tOMEGA\t\tDelta network Omega" << endl
+         << "\t\tCUSTOM FILENAME\tGraph of nodes and links described in the specified YAML file" << endl
+         << "\t-dtiles N\t\tSet the number of cores of delta networks" << endl
+         << "\t-dradix K\t\tSet the radix of the switches of delta networks (default 2)" << endl
+         << "\t-concentration N\tSet the number of PEs attached to each router (CMESH only)" << endl
+         << "\t-express K\t\tAdd express channels between routers K hops away (MESH and CMESH only)" << endl
+         << "\t-dimz N\t\t\tSet the number of layers of the 3D mesh (MESH3D only)" << endl
+         << "\t-vlink_latency N\tSet the latency of the vertical links [cycles] (MESH3D only)" << endl
+         << "\t-chiplet X Y\t\tSet the size of the chiplets [routers] (CHIPLET only)" << endl
+         << "\t-interposer_links N\tSet the number of interposer links per chiplet edge (CHIPLET only)" << endl
+         << "\t-interposer_latency N\tSet the latency of the interposer links [cycles] (CHIPLET only)" << endl
+         << "\t-interposer_width N\tSet the width of the interposer links [bit] (CHIPLET only)" << endl
          << "\t-routing TYPE\t\tSet the routing algorithm to one of the following:" << endl
          << "\t\tXY\t\tXY routing algorithm" << endl
+         << "\t\tTORUS_XY\tMinimal XY routing algorithm on torus topologies" << endl
+         << "\t\tEXPRESS_XY\tXY routing algorithm using the express channels" << endl
+         << "\t\tCHIPLET_XY\tXY routing algorithm across the interposer links of chiplets" << endl
          << "\t\tWEST_FIRST\tWest-First routing algorithm" << endl
          << "\t\tNORTH_LAST\tNorth-Last routing algorithm" << endl
          << "\t\tNEGATIVE_FIRST\tNegative-First routing algorithm" << endl
          << "\t\tODD_EVEN\tOdd-Even routing algorithm" << endl
+         << "\t\tDUATO\t\tFully adaptive routing with XY escape channels on VC 0 (requires -vca DYNAMIC)" << endl
          << "\t\tDYAD T\t\tDyAD routing algorithm with threshold T" << endl
          << "\t\tTABLE_BASED FILENAME\tRouting Table Based routing algorithm with table in the specified file" << endl
          << "\t-sel TYPE\t\tSet the selection strategy to one of the following:" << endl
          << "\t\tRANDOM\t\tRandom selection strategy" << endl
          << "\t\tBUFFER_LEVEL\tBuffer-Level Based selection strategy" << endl
          << "\t\tNOP\t\tNeighbors-on-Path selection strategy" << endl
+         << "\t\tRCA\t\tRegional Congestion Awareness selection strategy" << endl
+         << "\t-sa TYPE\t\tSet the switch allocator to one of the following:" << endl
+         << "\t\tRANDOM\t\tEach input picks at random among the outputs it holds the priority of (default)" << endl
+         << "\t\tSEPARABLE_IF\tSeparable input-first allocator with round-robin arbiters" << endl
+         << "\t\tSEPARABLE_OF\tSeparable output-first allocator with round-robin arbiters (iSLIP)" << endl
+         << "\t\tWAVEFRONT\tWavefront allocator" << endl
+         << "\t\tCLASS\t\tStrict priority of the lower traffic classes, then of the older packets" << endl
+         << "\t\tAGE\t\tOlder packets first" << endl
          <<	"\t-pir R TYPE\t\tSet the packet injection rate R [0..1] and the time distribution TYPE where TYPE is one of the following:" << endl
          << "\t\tpoisson\t\tMemory-less Poisson distribution" << endl
          << "\t\tburst R\t\tBurst distribution with given real burstness" << endl
@@ -238,6 +369,30 @@ void showHelp(char selfname[])
          << "\t\tbutterfly\tButterfly traffic distribution" << endl
          << "\t\tshuffle\t\tShuffle traffic distribution" << endl
          <<	"\t\ttable FILENAME\tTraffic Table Based traffic distribution with table in the specified file" << endl
+         << "\t\ttrace FILENAME\tReplay of the packets of the binary trace in the specified file" << endl
+         << "\t-trace_nodeps\t\tReplay the trace packets at their cycle, ignoring their dependencies" << endl
+         << "\t-pipeline STAGES\tSet the router pipeline: stages separated by ',' of units RC, VA, SA, ST" << endl
+         << "\t\t\t\tjoined by '+' when performed in the same cycle (default RC+VA+SA+ST)" << endl
+         << "\t-lookahead\t\tCompute routes one hop in advance, removing RC from the router pipeline" << endl
+         << "\t-speculative\t\tPerform switch allocation speculatively, in parallel with VC allocation" << endl
+         << "\t-sqsize N\t\tSet the depth of PE source queues [packets] (0 = unbounded)" << endl
+         << "\t-sqvcsize N\t\tSet the per-VC depth of PE source queues [packets] (0 = unbounded)" << endl
+         << "\t-sqpolicy TYPE\t\tSet the policy applied when a source queue is full to one of the following:" << endl
+         << "\t\tSTALL\t\tThe generated packet waits and the traffic source is stalled" << endl
+         << "\t\tDROP\t\tThe generated packet is dropped and counted" << endl
+         << "\t-request_reply\t\tMake the generated packets requests, each one answered by a reply of its destination" << endl
+         << "\t-reply_size N\t\tSet the size of the replies [flits]" << endl
+         << "\t-service_time N\t\tSet the cycles from the reception of a request to the generation of its reply" << endl
+         << "\t-max_outstanding N\tSet the requests a PE may wait a reply for, further ones are not generated (0 = unbounded)" << endl
+         << "\t-mc LIST\t\tReplace the cores of LIST, separated by ',', by memory controllers serving the requests" << endl
+         << "\t-mc_banks N\t\tSet the banks of each memory controller" << endl
+         << "\t-mc_latency N\t\tSet the cycles a bank takes to access the data of a request" << endl
+         << "\t-mc_bandwidth B\t\tSet the flits per cycle of the replies leaving each memory controller" << endl
+         << "\t-mc_ratio R\t\tSend a fraction R [0..1] of the requests to the memory controllers" << endl
+         << "\t-multicast R N\t\tMake a fraction R [0..1] of the generated packets multicast to N random cores (0 = broadcast)" << endl
+         << "\t-mcast_replication TYPE\tSet who replicates multicast packets to one of the following:" << endl
+         << "\t\tROUTER\t\tThe routers, along the tree of the routes to the destinations (default)" << endl
+         << "\t\tSOURCE\t\tThe source PE, sending a unicast packet to each destination in turn" << endl
          << "\t-hs ID P\t\tAdd node ID to hotspot nodes, with percentage P (0..1) (Only for 'random' traffic)" << endl
          << "\t-warmup N\t\tStart to collect statistics after N cycles" << endl
          << "\t-seed N\t\t\tSet the seed of the random generator (default time())" << endl
@@ -263,13 +418,22 @@ void showConfig()
          << "- mesh_dim_x = " << GlobalParams::mesh_dim_x << endl
          << "- mesh_dim_y = " << GlobalParams::mesh_dim_y << endl
          << "- buffer_depth = " << GlobalParams::buffer_depth << endl
+         << "- flow_control = " << GlobalParams::flow_control << endl
+         << "- buffer_organization = " << GlobalParams::buffer_organization << endl
+         << "- router_architecture = " << GlobalParams::router_architecture << endl
          << "- n_virtual_channels = " << GlobalParams::n_virtual_channels << endl
+         << "- vc_allocation = " << GlobalParams::vc_allocation << endl
+         << "- traffic_class_vcs = " << GlobalParams::traffic_class_vcs << endl
          << "- max_packet_size = " << GlobalParams::max_packet_size << endl
          << "- routing_algorithm = " << GlobalParams::routing_algorithm << endl
       // << "- routing_table_filename = " << GlobalParams::routing_table_filename << endl
          << "- selection_strategy = " << GlobalParams::selection_strategy << endl
          << "- packet_injection_rate = " << GlobalParams::packet_injection_rate << endl
          << "- probability_of_retransmission = " << GlobalParams::probability_of_retransmission << endl
+         << "- source_queue_size = " << GlobalParams::source_queue_size << endl
+         << "- source_queue_vc_size = " << GlobalParams::source_queue_vc_size << endl
+         << "- source_queue_policy = " << GlobalParams::source_queue_policy << endl
+         << "- multicast_rate = " << GlobalParams::multicast_rate << endl
          << "- traffic_distribution = " << GlobalParams::traffic_distribution << endl
          << "- clock_period = " << GlobalParams::clock_period_ps << "ps" << endl
          << "- simulation_time = " << GlobalParams::simulation_time << endl
@@ -277,9 +441,164 @@ void showConfig()
          << "- rnd_generator_seed = " << GlobalParams::rnd_generator_seed << endl;
 }
 
+// Derives the stage completing each unit of the router pipeline
+void configurePipeline()
+{
+    const char * units[PIPELINE_UNITS] = { "RC", "VA", "SA", "ST" };
+    int stage[PIPELINE_UNITS];
+
+    for (int u = 0; u < PIPELINE_UNITS; u++)
+	stage[u] = 0;
+
+    stringstream stages(GlobalParams::router_pipeline);
+    string stage_units;
+    int n = 0;
+
+    while (getline(stages, stage_units, ',')) {
+	stringstream unit_list(stage_units);
+	string unit;
+
+	n++;
+	while (getline(unit_list, unit, '+')) {
+	    int u = 0;
+
+	    while (u < PIPELINE_UNITS && unit != units[u])
+		u++;
+
+	    if (u == PIPELINE_UNITS || stage[u] != 0) {
+		cerr << "Error: router_pipeline must list RC, VA, SA and ST once each (found " << unit << ")" << endl;
+		exit(1);
+	    }
+	    stage[u] = n;
+	}
+    }
+
+    for (int u = 0; u < PIPELINE_UNITS; u++) {
+	if (stage[u] == 0) {
+	    cerr << "Error: router_pipeline lacks the " << units[u] << " stage" << endl;
+	    exit(1);
+	}
+	if (u > 0 && stage[u] < stage[u - 1]) {
+	    cerr << "Error: router_pipeline units must be in the RC, VA, SA, ST order" << endl;
+	    exit(1);
+	}
+    }
+
+    // The route is computed by the upstream router
+    if (GlobalParams::lookahead_routing)
+	stage[PIPELINE_RC] = 0;
+
+    // Switch allocation does not wait for the VC one
+    if (GlobalParams::speculative_allocation)
+	stage[PIPELINE_SA] = stage[PIPELINE_VA];
+
+    // Renumber the stages, dropping the ones left empty
+    for (int u = 0; u < PIPELINE_UNITS; u++) {
+	GlobalParams::pipeline_stage[u] = 0;
+	for (int s = 1; s <= stage[u]; s++)
+	    for (int w = 0; w < PIPELINE_UNITS; w++)
+		if (stage[w] == s) {
+		    GlobalParams::pipeline_stage[u]++;
+		    break;
+		}
+    }
+}
+
+// Splits the VCs among the traffic classes
+void configureTrafficClasses()
+{
+    stringstream list(GlobalParams::traffic_class_vcs);
+    string vcs;
+    int total = 0;
+
+    GlobalParams::class_vcs.clear();
+    while (getline(list, vcs, ',')) {
+	int n = atoi(vcs.c_str());
+	if (n < 1) {
+	    cerr << "Error: each traffic class needs at least one virtual channel" << endl;
+	    exit(1);
+	}
+	GlobalParams::class_vcs.push_back(n);
+	total += n;
+    }
+
+    if (!GlobalParams::class_vcs.empty() && total != GlobalParams::n_virtual_channels) {
+	cerr << "Error: traffic_class_vcs must split exactly the " << GlobalParams::n_virtual_channels
+	     << " virtual channels" << endl;
+	exit(1);
+    }
+}
+
+void configureMemoryControllers()
+{
+    stringstream list(GlobalParams::memory_controllers);
+    string core;
+
+    GlobalParams::memory_controller_cores.clear();
+    while (getline(list, core, ',')) {
+	int id = atoi(core.c_str());
+	if (id < 0 || count(GlobalParams::memory_controller_cores.begin(),
+			    GlobalParams::memory_controller_cores.end(), id) > 0) {
+	    cerr << "Error: invalid or repeated memory controller core " << core << endl;
+	    exit(1);
+	}
+	GlobalParams::memory_controller_cores.push_back(id);
+    }
+}
+
+void configureDVFSLevels()
+{
+    stringstream list(GlobalParams::dvfs_levels);
+    string level;
+
+    GlobalParams::dvfs_level_table.clear();
+    while (getline(list, level, ',')) {
+	double frequency, voltage;
+	char sep;
+	stringstream pair(level);
+
+	if (!(pair >> frequency >> sep >> voltage) || sep != ':' ||
+	    frequency <= 0 || frequency > 1 || voltage <= 0) {
+	    cerr << "Error: invalid DVFS level " << level << ", frequency must be in (0, 1] and voltage > 0" << endl;
+	    exit(1);
+	}
+
+	// Level 0 is the fastest one, the policy moves by one level
+	if (!GlobalParams::dvfs_level_table.empty() && frequency > GlobalParams::dvfs_level_table.back().first) {
+	    cerr << "Error: DVFS levels must be sorted by decreasing frequency" << endl;
+	    exit(1);
+	}
+	GlobalParams::dvfs_level_table.push_back(make_pair(frequency, voltage));
+    }
+
+    if (GlobalParams::dvfs_level_table.empty()) {
+	cerr << "Error: at least one DVFS level is needed" << endl;
+	exit(1);
+    }
+}
+
+// VCs of the smallest traffic class, where deadlock freedom needs VC classes
+int minClassVirtualChannels()
+{
+    int n = GlobalParams::n_virtual_channels;
+
+    for (unsigned int c = 0; c < GlobalParams::class_vcs.size(); c++)
+	n = min(n, GlobalParams::class_vcs[c]);
+
+    return n;
+}
+
 void checkConfiguration()
 {
-	if (GlobalParams::topology==TOPOLOGY_MESH)
+    configureTrafficClasses();
+
+	if (Topologies::get(GlobalParams::topology) == 0)
+	{
+		cerr << "Error: topology " << GlobalParams::topology << " is not supported" << endl;
+		exit(1);
+	}
+
+	if (isMeshTopology())
 	{
 		if (GlobalParams::mesh_dim_x <= 1) {
 			cerr << "Error: dimx must be greater than 1" << endl;
@@ -295,19 +614,38 @@ void checkConfiguration()
 			cerr << "Error: winoc_dst_hops currently supported only in delta topologies" << endl;
 			exit(1);
 		}
+		if ((GlobalParams::topology == TOPOLOGY_TORUS || GlobalParams::topology == TOPOLOGY_FOLDED_TORUS) &&
+		    minClassVirtualChannels() < 2)
+		{
+			cerr << "Error: " << GlobalParams::topology << " topology requires at least 2 virtual channels (dateline classes)" << endl;
+			exit(1);
+		}
+	}
+	else if (GlobalParams::topology==TOPOLOGY_CUSTOM)
+	{
+		if (GlobalParams::topology_filename.empty())
+		{
+			cerr << "Error: CUSTOM topology requires a topology_filename" << endl;
+			exit(1);
+		}
 	}
 	else // other delta topologies
 	{
+		if (GlobalParams::delta_radix < 2)
+		{
+			cerr << "Error: delta_radix must be at least 2" << endl;
+			exit(1);
+		}
 		int x = GlobalParams::n_delta_tiles;
 		while( x != 1)
 		{
-			//checks whether a number is divisible by 2
-			if(x % 2 != 0)
+			//checks whether a number is divisible by the radix
+			if(x < 1 || x % GlobalParams::delta_radix != 0)
 			{
-				cerr << "Error: n_delta_tiles must be a power of 2 " << endl;
+				cerr << "Error: n_delta_tiles must be a power of delta_radix (" << GlobalParams::delta_radix << ")" << endl;
 				exit(1);
 			}
-			x /= 2;
+			x /= GlobalParams::delta_radix;
 		}
 		if (GlobalParams::routing_algorithm!="DELTA")
 		{
@@ -316,6 +654,163 @@ void checkConfiguration()
 		}
 	}
 
+	if (GlobalParams::topology == TOPOLOGY_CMESH)
+	{
+		if (GlobalParams::concentration < 1 || GlobalParams::concentration > MAX_CONCENTRATION)
+		{
+			cerr << "Error: concentration must be in the range [1," << MAX_CONCENTRATION << "]" << endl;
+			exit(1);
+		}
+		if (GlobalParams::use_winoc)
+		{
+			cerr << "Error: wireless transmission is not supported in CMESH topology" << endl;
+			exit(1);
+		}
+	}
+	else if (GlobalParams::concentration != 1)
+	{
+		cerr << "Error: concentration makes sense only in CMESH topology" << endl;
+		exit(1);
+	}
+
+	if (GlobalParams::topology == TOPOLOGY_MESH3D)
+	{
+		if (GlobalParams::mesh_dim_z <= 1)
+		{
+			cerr << "Error: dimz must be greater than 1" << endl;
+			exit(1);
+		}
+		if (GlobalParams::vertical_link_latency < 1)
+		{
+			cerr << "Error: vertical_link_latency must be at least 1 cycle" << endl;
+			exit(1);
+		}
+		if (GlobalParams::routing_algorithm != "XY" && GlobalParams::routing_algorithm != "NEGATIVE_FIRST" &&
+		    GlobalParams::routing_algorithm != ROUTING_DUATO)
+		{
+			cerr << "Error: MESH3D topology supports only XY, NEGATIVE_FIRST and DUATO routing algorithms" << endl;
+			exit(1);
+		}
+		if (GlobalParams::selection_strategy == "NOP")
+		{
+			cerr << "Error: NOP selection strategy is not supported in MESH3D topology" << endl;
+			exit(1);
+		}
+		if (GlobalParams::use_winoc)
+		{
+			cerr << "Error: wireless transmission is not supported in MESH3D topology" << endl;
+			exit(1);
+		}
+	}
+	else if (GlobalParams::mesh_dim_z != 1)
+	{
+		cerr << "Error: dimz makes sense only in MESH3D topology" << endl;
+		exit(1);
+	}
+
+	if (GlobalParams::topology == TOPOLOGY_CHIPLET)
+	{
+		if (GlobalParams::chiplet_dim_x < 1 || GlobalParams::chiplet_dim_y < 1 ||
+		    GlobalParams::mesh_dim_x % GlobalParams::chiplet_dim_x != 0 ||
+		    GlobalParams::mesh_dim_y % GlobalParams::chiplet_dim_y != 0)
+		{
+			cerr << "Error: chiplet sizes must divide the mesh sizes" << endl;
+			exit(1);
+		}
+		if (GlobalParams::interposer_links < 1)
+		{
+			cerr << "Error: at least one interposer link per chiplet edge is required" << endl;
+			exit(1);
+		}
+		if (GlobalParams::interposer_link_latency < 1)
+		{
+			cerr << "Error: interposer_link_latency must be at least 1 cycle" << endl;
+			exit(1);
+		}
+		if (GlobalParams::interposer_link_width < 0 || GlobalParams::interposer_link_width > GlobalParams::flit_size)
+		{
+			cerr << "Error: interposer_link_width must be in the range [1," << GlobalParams::flit_size
+			     << "] (0 for flit_size)" << endl;
+			exit(1);
+		}
+		if (GlobalParams::routing_algorithm != ROUTING_CHIPLET_XY)
+		{
+			cerr << "Error: CHIPLET topology requires CHIPLET_XY routing algorithm" << endl;
+			exit(1);
+		}
+		if (minClassVirtualChannels() < 2)
+		{
+			cerr << "Error: CHIPLET topology requires at least 2 virtual channels" << endl;
+			exit(1);
+		}
+		if (GlobalParams::use_winoc)
+		{
+			cerr << "Error: wireless transmission is not supported in CHIPLET topology" << endl;
+			exit(1);
+		}
+	}
+	else if (GlobalParams::chiplet_dim_x != 0 || GlobalParams::chiplet_dim_y != 0)
+	{
+		cerr << "Error: chiplet sizes make sense only in CHIPLET topology" << endl;
+		exit(1);
+	}
+
+	if (GlobalParams::routing_algorithm == ROUTING_CHIPLET_XY &&
+	    GlobalParams::topology != TOPOLOGY_CHIPLET)
+	{
+		cerr << "Error: CHIPLET_XY routing algorithm requires CHIPLET topology" << endl;
+		exit(1);
+	}
+
+	if (GlobalParams::routing_algorithm == ROUTING_DUATO)
+	{
+		if (GlobalParams::topology != TOPOLOGY_MESH &&
+		    GlobalParams::topology != TOPOLOGY_CMESH &&
+		    GlobalParams::topology != TOPOLOGY_MESH3D)
+		{
+			cerr << "Error: DUATO routing algorithm requires MESH, CMESH or MESH3D topology" << endl;
+			exit(1);
+		}
+		// Deflection routers only take its minimal directions
+		if (GlobalParams::router_architecture == ROUTER_BUFFERED &&
+		    (minClassVirtualChannels() < 2 ||
+		     GlobalParams::vc_allocation != VC_ALLOCATION_DYNAMIC))
+		{
+			cerr << "Error: DUATO routing algorithm requires at least 2 virtual channels and DYNAMIC VC allocation" << endl;
+			exit(1);
+		}
+	}
+
+	if (GlobalParams::express_interval != 0)
+	{
+		if (GlobalParams::topology != TOPOLOGY_MESH && GlobalParams::topology != TOPOLOGY_CMESH)
+		{
+			cerr << "Error: express channels are supported only in MESH and CMESH topologies" << endl;
+			exit(1);
+		}
+		if (GlobalParams::express_interval < 2)
+		{
+			cerr << "Error: express_interval must be 0 (no express channels) or greater than 1" << endl;
+			exit(1);
+		}
+	}
+
+	if (GlobalParams::routing_algorithm == ROUTING_EXPRESS_XY &&
+	    GlobalParams::topology != TOPOLOGY_MESH &&
+	    GlobalParams::topology != TOPOLOGY_CMESH)
+	{
+		cerr << "Error: EXPRESS_XY routing algorithm requires MESH or CMESH topology" << endl;
+		exit(1);
+	}
+
+	if (GlobalParams::routing_algorithm == ROUTING_TORUS_XY &&
+	    GlobalParams::topology != TOPOLOGY_TORUS &&
+	    GlobalParams::topology != TOPOLOGY_FOLDED_TORUS)
+	{
+		cerr << "Error: TORUS_XY routing algorithm requires TORUS or FOLDED_TORUS topology" << endl;
+		exit(1);
+	}
+
 	if (GlobalParams::winoc_dst_hops>0) {
 		if (GlobalParams::topology != TOPOLOGY_BUTTERFLY)
 		{
@@ -333,6 +828,128 @@ void checkConfiguration()
 	cerr << "Error: buffer must be >= 1" << endl;
 	exit(1);
     }
+    if (GlobalParams::buffer_organization != BUFFER_ORGANIZATION_PRIVATE &&
+	GlobalParams::buffer_organization != BUFFER_ORGANIZATION_DAMQ) {
+	cerr << "Error: buffer organization must be " << BUFFER_ORGANIZATION_PRIVATE
+	    << " or " << BUFFER_ORGANIZATION_DAMQ << endl;
+	exit(1);
+    }
+    if (GlobalParams::damq_reserved < 1) {
+	cerr << "Error: damq_reserved must be >= 1" << endl;
+	exit(1);
+    }
+    if (GlobalParams::damq_pool_size != 0 &&
+	GlobalParams::damq_pool_size < GlobalParams::n_virtual_channels * GlobalParams::damq_reserved) {
+	cerr << "Error: damq_pool_size must hold the reserved slots of all the VCs" << endl;
+	exit(1);
+    }
+    if (GlobalParams::router_architecture != ROUTER_BUFFERED &&
+	GlobalParams::router_architecture != ROUTER_DEFLECTION) {
+	cerr << "Error: router architecture must be " << ROUTER_BUFFERED
+	    << " or " << ROUTER_DEFLECTION << endl;
+	exit(1);
+    }
+    if (GlobalParams::router_architecture == ROUTER_DEFLECTION) {
+	if (GlobalParams::deflection_priority != DEFLECTION_OLDEST_FIRST &&
+	    GlobalParams::deflection_priority != DEFLECTION_GOLDEN) {
+	    cerr << "Error: deflection priority must be " << DEFLECTION_OLDEST_FIRST
+		<< " or " << DEFLECTION_GOLDEN << endl;
+	    exit(1);
+	}
+	if (GlobalParams::golden_epoch < 1) {
+	    cerr << "Error: golden_epoch must be >= 1" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::use_winoc) {
+	    cerr << "Error: deflection routers do not support wireless hubs" << endl;
+	    exit(1);
+	}
+    }
+    if (GlobalParams::deadlock_check_period < 0) {
+	cerr << "Error: deadlock_check_period must be >= 0" << endl;
+	exit(1);
+    }
+    if (GlobalParams::clock_domains != CLOCK_DOMAINS_NONE &&
+	GlobalParams::clock_domains != CLOCK_DOMAINS_ROUTER &&
+	GlobalParams::clock_domains != CLOCK_DOMAINS_REGION) {
+	cerr << "Error: clock domains must be " << CLOCK_DOMAINS_NONE << ", "
+	    << CLOCK_DOMAINS_ROUTER << " or " << CLOCK_DOMAINS_REGION << endl;
+	exit(1);
+    }
+    if (GlobalParams::clock_domains != CLOCK_DOMAINS_NONE) {
+	configureDVFSLevels();
+	if (GlobalParams::clock_region_size < 1) {
+	    cerr << "Error: clock_region_size must be >= 1" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::cdc_sync_cycles < 0) {
+	    cerr << "Error: cdc_sync_cycles must be >= 0" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::dvfs_policy != DVFS_STATIC && GlobalParams::dvfs_policy != DVFS_UTILIZATION) {
+	    cerr << "Error: DVFS policy must be " << DVFS_STATIC << " or " << DVFS_UTILIZATION << endl;
+	    exit(1);
+	}
+	if (GlobalParams::dvfs_initial_level < 0 ||
+	    GlobalParams::dvfs_initial_level >= (int) GlobalParams::dvfs_level_table.size()) {
+	    cerr << "Error: dvfs_initial_level must be in [0, " << GlobalParams::dvfs_level_table.size() - 1 << "]" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::dvfs_period < 1) {
+	    cerr << "Error: dvfs_period must be >= 1" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::dvfs_down_threshold > GlobalParams::dvfs_up_threshold) {
+	    cerr << "Error: dvfs_down_threshold must not be greater than dvfs_up_threshold" << endl;
+	    exit(1);
+	}
+	// Deflection routers must forward each flit in the next cycle
+	if (GlobalParams::router_architecture == ROUTER_DEFLECTION) {
+	    cerr << "Error: clock domains are only supported by buffered routers" << endl;
+	    exit(1);
+	}
+    }
+    if (GlobalParams::power_gating != POWER_GATING_NONE &&
+	GlobalParams::power_gating != POWER_GATING_TIMEOUT &&
+	GlobalParams::power_gating != POWER_GATING_BREAK_EVEN) {
+	cerr << "Error: power gating must be " << POWER_GATING_NONE << ", "
+	    << POWER_GATING_TIMEOUT << " or " << POWER_GATING_BREAK_EVEN << endl;
+	exit(1);
+    }
+    if (GlobalParams::power_gating != POWER_GATING_NONE) {
+	if (GlobalParams::power_gating_timeout < 1) {
+	    cerr << "Error: power_gating_timeout must be >= 1" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::power_gating_wakeup_energy < 0) {
+	    cerr << "Error: power_gating_wakeup_energy must be >= 0" << endl;
+	    exit(1);
+	}
+	if (GlobalParams::power_gating_wakeup < 1) {
+	    cerr << "Error: power_gating_wakeup must be >= 1" << endl;
+	    exit(1);
+	}
+	// Flits can not be held upstream of bufferless routers and the
+	// hubs do not take part in the wake-up handshake
+	if (GlobalParams::router_architecture == ROUTER_DEFLECTION || GlobalParams::use_winoc) {
+	    cerr << "Error: power gating is only supported by buffered routers without wireless hubs" << endl;
+	    exit(1);
+	}
+    }
+    if (GlobalParams::flow_control != FLOW_CONTROL_ABP &&
+	GlobalParams::flow_control != FLOW_CONTROL_CREDIT) {
+	cerr << "Error: flow control must be " << FLOW_CONTROL_ABP
+	    << " or " << FLOW_CONTROL_CREDIT << endl;
+	exit(1);
+    }
+    if (GlobalParams::r2r_link_latency < 1) {
+	cerr << "Error: r2r_link_latency must be at least 1 cycle" << endl;
+	exit(1);
+    }
+    if (GlobalParams::link_mm_per_cycle < 0) {
+	cerr << "Error: link_mm_per_cycle must be >= 0" << endl;
+	exit(1);
+    }
     if (GlobalParams::flit_size <= 0) {
 	cerr << "Error: flit_size must be > 0" << endl;
 	exit(1);
@@ -364,17 +981,115 @@ void checkConfiguration()
 	exit(1);
     }
 
+    configurePipeline();
+
+    if (GlobalParams::source_queue_size < 0 || GlobalParams::source_queue_vc_size < 0) {
+	cerr << "Error: source queue size must be >= 0" << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::vc_allocation != VC_ALLOCATION_STATIC &&
+	GlobalParams::vc_allocation != VC_ALLOCATION_DYNAMIC) {
+	cerr << "Error: VC allocation must be " << VC_ALLOCATION_STATIC
+	    << " or " << VC_ALLOCATION_DYNAMIC << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::source_queue_policy != SOURCE_QUEUE_STALL &&
+	GlobalParams::source_queue_policy != SOURCE_QUEUE_DROP) {
+	cerr << "Error: source queue policy must be " << SOURCE_QUEUE_STALL
+	    << " or " << SOURCE_QUEUE_DROP << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::multicast_rate < 0 || GlobalParams::multicast_rate > 1) {
+	cerr << "Error: multicast rate must be in the range 0..1" << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::multicast_destinations < 0) {
+	cerr << "Error: multicast destinations must be >= 0" << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::multicast_replication != MULTICAST_ROUTER &&
+	GlobalParams::multicast_replication != MULTICAST_SOURCE) {
+	cerr << "Error: multicast replication must be " << MULTICAST_ROUTER
+	    << " or " << MULTICAST_SOURCE << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::multicast_rate > 0 && GlobalParams::multicast_replication == MULTICAST_ROUTER &&
+	(GlobalParams::router_architecture != ROUTER_BUFFERED || GlobalParams::use_winoc)) {
+	cerr << "Error: multicast replication in the routers requires buffered routers without wireless hubs" << endl;
+	exit(1);
+    }
+
+    if (GlobalParams::request_reply) {
+	if (GlobalParams::reply_packet_size < 2) {
+	    cerr << "Error: reply packet size must be >= 2" << endl;
+	    exit(1);
+	}
+
+	if (GlobalParams::reply_service_time < 0 || GlobalParams::max_outstanding_requests < 0) {
+	    cerr << "Error: reply service time and max outstanding requests must be >= 0" << endl;
+	    exit(1);
+	}
+
+	// Replies go back to the single requester of a packet generated by
+	// the traffic source
+	if (GlobalParams::multicast_rate > 0 || GlobalParams::traffic_distribution == TRAFFIC_TRACE) {
+	    cerr << "Error: request/reply traffic does not support multicast and trace traffic" << endl;
+	    exit(1);
+	}
+    }
+
+    configureMemoryControllers();
+    if (!GlobalParams::memory_controller_cores.empty()) {
+	// Memory controllers only serve requests
+	if (!GlobalParams::request_reply) {
+	    cerr << "Error: memory controllers require request/reply traffic" << endl;
+	    exit(1);
+	}
+
+	if (GlobalParams::memory_banks < 1 || GlobalParams::memory_latency < 0 ||
+	    GlobalParams::memory_bandwidth <= 0) {
+	    cerr << "Error: memory controllers need at least one bank, a latency >= 0 and a bandwidth > 0" << endl;
+	    exit(1);
+	}
+
+	if (GlobalParams::memory_traffic_ratio < 0 || GlobalParams::memory_traffic_ratio > 1) {
+	    cerr << "Error: memory traffic ratio must be in the range 0..1" << endl;
+	    exit(1);
+	}
+    }
+
+    if (GlobalParams::traffic_distribution == TRAFFIC_TRACE) {
+	if (GlobalParams::traffic_trace_filename.empty()) {
+	    cerr << "Error: trace traffic requires a traffic_trace_filename" << endl;
+	    exit(1);
+	}
+
+	// Dependencies refer to the packets of the trace
+	if (GlobalParams::multicast_rate > 0) {
+	    cerr << "Error: trace traffic can not be turned into multicast" << endl;
+	    exit(1);
+	}
+    }
+
     for (unsigned int i = 0; i < GlobalParams::hotspots.size(); i++) {
-	if (GlobalParams::topology==TOPOLOGY_MESH){
+	if (isMeshTopology()){
 		if (GlobalParams::hotspots[i].first >=
 		    GlobalParams::mesh_dim_x *
-		    GlobalParams::mesh_dim_y) {
+		    GlobalParams::mesh_dim_y *
+		    GlobalParams::mesh_dim_z *
+		    GlobalParams::concentration) {
 		    cerr << "Error: hotspot node " << GlobalParams::
 			hotspots[i].first << " is invalid (out of range)" << endl;
 		    exit(1);
 		}
 	}
-	else {
+	else if (GlobalParams::topology!=TOPOLOGY_CUSTOM) {
 		if (GlobalParams::hotspots[i].first >= GlobalParams::n_delta_tiles){
 		    cerr << "Error: hotspot node " << GlobalParams::hotspots[i].first << " is invalid (out of range)" << endl;
 		    exit(1);
@@ -424,11 +1139,6 @@ void checkConfiguration()
 	exit(1);
     }
 
-    if (GlobalParams::n_virtual_channels>1 && GlobalParams::selection_strategy.compare("BUFFER_LEVEL")==0)
-    {
-	cerr << "Error: Buffer level selection strategy can be used only with a single virtual channel" << endl;
-	exit(1);
-    }
     if (GlobalParams::n_virtual_channels>MAX_VIRTUAL_CHANNELS) 
     {
 	cerr << "Error: cannot use more than " << MAX_VIRTUAL_CHANNELS << " virtual channels." << endl
@@ -473,11 +1183,81 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 	    else if (!strcmp(arg_vet[i], "-dimy"))
 		GlobalParams::mesh_dim_y = atoi(arg_vet[++i]);
 
+	    else if (!strcmp(arg_vet[i], "-dimz"))
+		GlobalParams::mesh_dim_z = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-vlink_latency"))
+		GlobalParams::vertical_link_latency = atoi(arg_vet[++i]);
+
+	    else if (!strcmp(arg_vet[i], "-chiplet"))
+	    {
+		GlobalParams::chiplet_dim_x = atoi(arg_vet[++i]);
+		GlobalParams::chiplet_dim_y = atoi(arg_vet[++i]);
+	    }
+	    else if (!strcmp(arg_vet[i], "-interposer_links"))
+		GlobalParams::interposer_links = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-interposer_latency"))
+		GlobalParams::interposer_link_latency = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-interposer_width"))
+		GlobalParams::interposer_link_width = atoi(arg_vet[++i]);
+
+	    else if (!strcmp(arg_vet[i], "-concentration"))
+		GlobalParams::concentration = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-express"))
+		GlobalParams::express_interval = atoi(arg_vet[++i]);
+
 	    else if (!strcmp(arg_vet[i], "-dtiles"))
 		GlobalParams::n_delta_tiles = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-dradix"))
+		GlobalParams::delta_radix = atoi(arg_vet[++i]);
 
 	    else if (!strcmp(arg_vet[i], "-buffer"))
 		GlobalParams::buffer_depth = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-buffers"))
+		GlobalParams::buffer_organization = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-damq_size"))
+		GlobalParams::damq_pool_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-damq_reserved"))
+		GlobalParams::damq_reserved = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-router"))
+		GlobalParams::router_architecture = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-deflection_priority"))
+		GlobalParams::deflection_priority = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-golden_epoch"))
+		GlobalParams::golden_epoch = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-deadlock_check"))
+		GlobalParams::deadlock_check_period = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-gating"))
+		GlobalParams::power_gating = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-gating_timeout"))
+		GlobalParams::power_gating_timeout = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-gating_wakeup"))
+		GlobalParams::power_gating_wakeup = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-gating_wakeup_energy"))
+		GlobalParams::power_gating_wakeup_energy = atof(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-clock_domains"))
+		GlobalParams::clock_domains = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-region_size"))
+		GlobalParams::clock_region_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-cdc_sync"))
+		GlobalParams::cdc_sync_cycles = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-dvfs_levels"))
+		GlobalParams::dvfs_levels = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-dvfs"))
+		GlobalParams::dvfs_policy = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-dvfs_level"))
+		GlobalParams::dvfs_initial_level = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-dvfs_period"))
+		GlobalParams::dvfs_period = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-dvfs_thresholds")) {
+		GlobalParams::dvfs_up_threshold = atof(arg_vet[++i]);
+		GlobalParams::dvfs_down_threshold = atof(arg_vet[++i]);
+	    }
+	    else if (!strcmp(arg_vet[i], "-fc"))
+		GlobalParams::flow_control = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-link_latency"))
+		GlobalParams::r2r_link_latency = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-mm_per_cycle"))
+		GlobalParams::link_mm_per_cycle = atof(arg_vet[++i]);
 	    else if (!strcmp(arg_vet[i], "-buffer_tt"))
 		setBufferToTile(atoi(arg_vet[++i]));
 	    else if (!strcmp(arg_vet[i], "-buffer_ft"))
@@ -506,6 +1286,8 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 	    else if (!strcmp(arg_vet[i], "-topology")) 
 	    {
 		    GlobalParams::topology = arg_vet[++i];
+		    if (GlobalParams::topology == TOPOLOGY_CUSTOM)
+			GlobalParams::topology_filename = arg_vet[++i];
             cout << "Changing topology to " << GlobalParams::topology << endl;
         }
 	    else if (!strcmp(arg_vet[i], "-routing")) 
@@ -522,6 +1304,12 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 	    else if (!strcmp(arg_vet[i], "-sel")) {
 		GlobalParams::selection_strategy = arg_vet[++i];
 	    } 
+	    else if (!strcmp(arg_vet[i], "-sa"))
+		GlobalParams::switch_allocator = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-vca"))
+		GlobalParams::vc_allocation = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-class_vcs"))
+		GlobalParams::traffic_class_vcs = arg_vet[++i];
 	    else if (!strcmp(arg_vet[i], "-pir")) 
 	    {
 		
@@ -573,12 +1361,53 @@ void parseCmdLine(int arg_num, char *arg_vet[])
 		    GlobalParams::traffic_distribution =
 			TRAFFIC_TABLE_BASED;
 		    GlobalParams::traffic_table_filename = arg_vet[++i];
+		} else if (!strcmp(traffic, "trace")) {
+		    GlobalParams::traffic_distribution = TRAFFIC_TRACE;
+		    GlobalParams::traffic_trace_filename = arg_vet[++i];
 		} else if (!strcmp(traffic, "local")) {
 		    GlobalParams::traffic_distribution = TRAFFIC_LOCAL;
 		    GlobalParams::locality=atof(arg_vet[++i]);
 		}
 		else assert(false);
 	    } 
+	    else if (!strcmp(arg_vet[i], "-pipeline"))
+		GlobalParams::router_pipeline = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-trace_nodeps"))
+		GlobalParams::trace_dependencies = false;
+	    else if (!strcmp(arg_vet[i], "-lookahead"))
+		GlobalParams::lookahead_routing = true;
+	    else if (!strcmp(arg_vet[i], "-speculative"))
+		GlobalParams::speculative_allocation = true;
+	    else if (!strcmp(arg_vet[i], "-sqsize"))
+		GlobalParams::source_queue_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-sqvcsize"))
+		GlobalParams::source_queue_vc_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-sqpolicy"))
+		GlobalParams::source_queue_policy = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-request_reply"))
+		GlobalParams::request_reply = true;
+	    else if (!strcmp(arg_vet[i], "-reply_size"))
+		GlobalParams::reply_packet_size = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-service_time"))
+		GlobalParams::reply_service_time = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-max_outstanding"))
+		GlobalParams::max_outstanding_requests = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-mc"))
+		GlobalParams::memory_controllers = arg_vet[++i];
+	    else if (!strcmp(arg_vet[i], "-mc_banks"))
+		GlobalParams::memory_banks = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-mc_latency"))
+		GlobalParams::memory_latency = atoi(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-mc_bandwidth"))
+		GlobalParams::memory_bandwidth = atof(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-mc_ratio"))
+		GlobalParams::memory_traffic_ratio = atof(arg_vet[++i]);
+	    else if (!strcmp(arg_vet[i], "-multicast")) {
+		GlobalParams::multicast_rate = atof(arg_vet[++i]);
+		GlobalParams::multicast_destinations = atoi(arg_vet[++i]);
+	    }
+	    else if (!strcmp(arg_vet[i], "-mcast_replication"))
+		GlobalParams::multicast_replication = arg_vet[++i];
 	    else if (!strcmp(arg_vet[i], "-hs")) 
 	    {
 		int node = atoi(arg_vet[++i]);
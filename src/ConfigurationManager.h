@@ -176,6 +176,9 @@ namespace YAML {
         static bool decode(const Node& node, PowerConfig& powerConfig) {
             powerConfig.bufferPowerConfig = node["Buffer"].as<BufferPowerConfig>();
             powerConfig.linkBitLinePowerConfig = node["LinkBitLine"].as<LinkBitLinePowerConfig>();
+            powerConfig.hasVerticalLinkBitLine = node["VerticalLinkBitLine"].IsDefined();
+            if (powerConfig.hasVerticalLinkBitLine)
+                powerConfig.verticalLinkBitLinePowerConfig = node["VerticalLinkBitLine"].as<pair<double, double> >();
             powerConfig.routerPowerConfig = node["Router"].as<RouterPowerConfig>();
             powerConfig.hubPowerConfig = node["Hub"].as<HubPowerConfig>();
             return true;
@@ -0,0 +1,131 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the clock domains and of the DVFS controller
+ */
+
+#include <cmath>
+#include <map>
+#include "DVFSController.h"
+#include "NoC.h"
+
+bool ClockDomain::edge(const long n) const
+{
+    double f = frequency;
+    long start = start_cycle;
+
+    if (n < start_cycle) {
+	f = old_frequency;
+	start = old_start_cycle;
+    }
+
+    // An edge each time a whole period of the domain clock has elapsed
+    return floor((n - start + 1) * f) > floor((n - start) * f);
+}
+
+DVFSController::DVFSController(NoC * _noc)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    int size = GlobalParams::clock_region_size;
+
+    // Regions are blocks of coordinates, or of ids for the nodes without
+    // coordinates
+    map < vector < int >, int > region_domain;
+
+    noc = _noc;
+    transitions = 0;
+    node_domain.assign(graph->size(), NOT_VALID);
+
+    for (int id = 0; id < graph->size(); id++) {
+	Coord c = graph->getCoord(id);
+	vector < int > region;
+
+	if (GlobalParams::clock_domains == CLOCK_DOMAINS_ROUTER)
+	    region.push_back(id);
+	else if (c.x != NOT_VALID && c.y != NOT_VALID) {
+	    region.push_back(c.x / size);
+	    region.push_back(c.y / size);
+	    region.push_back(c.z);
+	}
+	else {
+	    region.push_back(NOT_VALID);
+	    region.push_back(id / (size * size));
+	}
+
+	if (region_domain.count(region) == 0) {
+	    region_domain[region] = domains.size();
+	    domains.push_back(ClockDomain());
+	}
+
+	node_domain[id] = region_domain[region];
+	domains[node_domain[id]].nodes.push_back(id);
+    }
+}
+
+void DVFSController::update(const bool reset, const long cycle)
+{
+    if (reset) {
+	for (unsigned int k = 0; k < domains.size(); k++) {
+	    ClockDomain & d = domains[k];
+
+	    d.frequency = d.old_frequency = 1.0;
+	    d.start_cycle = d.old_start_cycle = 0;
+	    d.ticks = d.period_ticks = d.busy_ticks = 0;
+	    setLevel(d, GlobalParams::dvfs_initial_level, 0);
+	}
+	transitions = 0;
+	return;
+    }
+
+    if (GlobalParams::dvfs_policy != DVFS_UTILIZATION || cycle % GlobalParams::dvfs_period != 0)
+	return;
+
+    int slowest = GlobalParams::dvfs_level_table.size() - 1;
+
+    for (unsigned int k = 0; k < domains.size(); k++) {
+	ClockDomain & d = domains[k];
+	double utilization = (d.period_ticks == 0) ? 0.0 : (double) d.busy_ticks / d.period_ticks;
+	int level = d.level;
+
+	if (utilization > GlobalParams::dvfs_up_threshold && level > 0)
+	    level--;
+	else if (utilization < GlobalParams::dvfs_down_threshold && level < slowest)
+	    level++;
+
+	d.period_ticks = d.busy_ticks = 0;
+
+	if (level != d.level) {
+	    setLevel(d, level, cycle + 1);
+	    transitions++;
+	}
+    }
+}
+
+void DVFSController::setLevel(ClockDomain & d, const int level, const long cycle)
+{
+    d.old_frequency = d.frequency;
+    d.old_start_cycle = d.start_cycle;
+    d.level = level;
+    d.frequency = GlobalParams::dvfs_level_table[level].first;
+    d.start_cycle = cycle;
+
+    for (unsigned int k = 0; k < d.nodes.size(); k++)
+	noc->node[d.nodes[k]]->r->power.setVoltage(GlobalParams::dvfs_level_table[level].second);
+}
+
+double DVFSController::getAverageFrequency(const long cycles) const
+{
+    unsigned long ticks = 0;
+
+    if (cycles <= 0)
+	return 0.0;
+
+    for (unsigned int k = 0; k < domains.size(); k++)
+	ticks += domains[k].ticks;
+
+    return (double) ticks / ((double) node_domain.size() * cycles);
+}
@@ -0,0 +1,70 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the clock domains and of the DVFS controller
+ */
+
+#ifndef __NOXIMDVFSCONTROLLER_H__
+#define __NOXIMDVFSCONTROLLER_H__
+
+#include <vector>
+#include "DataStructs.h"
+#include "GlobalParams.h"
+
+using namespace std;
+
+class NoC;
+
+// ClockDomain -- routers sharing the clock and the supply voltage. The
+// clock is derived from the nominal one, the routers being enabled in
+// frequency x nominal cycles out of each nominal one
+struct ClockDomain {
+    vector < int > nodes;	// Routers of the domain
+    int level;			// DVFS level in use
+    double frequency;		// Relative to the nominal clock
+    long start_cycle;		// Nominal cycle the frequency applies from
+    double old_frequency;	// Frequency up to start_cycle
+    long old_start_cycle;
+
+    unsigned long ticks;	// Router cycles since reset
+    unsigned long period_ticks;	// Router cycles in the current DVFS period
+    unsigned long busy_ticks;	// Router cycles with flits in the input buffers
+
+    // True if the routers are clocked in nominal cycle n
+    bool edge(const long n) const;
+};
+
+// DVFSController -- splits the routers in clock domains, each one at a
+// DVFS level, and changes the levels according to the DVFS policy
+class DVFSController {
+
+  public:
+
+    DVFSController(NoC * _noc);
+
+    ClockDomain * getDomain(const int node) { return &domains[node_domain[node]]; }
+    bool sameDomain(const int a, const int b) const { return node_domain[a] == node_domain[b]; }
+    int getDomainCount() const { return domains.size(); }
+
+    // Called at each nominal cycle. New levels apply from the next one
+    void update(const bool reset, const long cycle);
+
+    // Router cycles relative to the nominal ones, and level changes
+    double getAverageFrequency(const long cycles) const;
+    unsigned long getTransitions() const { return transitions; }
+
+  private:
+
+    NoC * noc;
+    vector < ClockDomain > domains;
+    vector < int > node_domain;	// Domain of each node
+    unsigned long transitions;
+
+    void setLevel(ClockDomain & d, const int level, const long cycle);
+};
+
+#endif
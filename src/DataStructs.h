@@ -12,16 +12,20 @@
 #define _DATASTRUCS_H__
 
 #include <systemc.h>
+#include <bitset>
 #include "GlobalParams.h"
 
-// Coord -- XY coordinates type of the Tile inside the Mesh
+// Coord -- XYZ coordinates type of the Tile inside the Mesh
 class Coord {
   public:
     int x;			// X coordinate
     int y;			// Y coordinate
+    int z;			// Layer of 3D meshes, 0 otherwise
+
+    Coord() : x(0), y(0), z(0) {}
 
     inline bool operator ==(const Coord & coord) const {
-	return (coord.x == x && coord.y == y);
+	return (coord.x == x && coord.y == y && coord.z == z);
 }};
 
 // FlitType -- Flit type enumeration
@@ -29,6 +33,11 @@ enum FlitType {
     FLIT_TYPE_HEAD, FLIT_TYPE_BODY, FLIT_TYPE_TAIL
 };
 
+// TransactionType -- role of a packet in request/reply traffic
+enum TransactionType {
+    TRANSACTION_NONE, TRANSACTION_REQUEST, TRANSACTION_REPLY
+};
+
 // Payload -- Payload definition
 struct Payload {
     sc_uint<32> data;	// Bus for the data to be exchanged
@@ -37,18 +46,31 @@ struct Payload {
 	return (payload.data == data);
 }};
 
+// CoreSet -- Destination cores of a multicast packet
+typedef std::bitset < MAX_MULTICAST_CORES > CoreSet;
+
 // Packet -- Packet definition
 struct Packet {
     int src_id;
-    int dst_id;
+    int dst_id;			// NOT_VALID for multicast packets replicated by the routers
+    CoreSet dst_set;		// Destinations of multicast packets, empty for unicast ones
     int vc_id;
+    int traffic_class;		// Lower classes have higher priority
     double timestamp;		// SC timestamp at packet generation
     int size;
     int flit_left;		// Number of remaining flits inside the packet
     bool use_low_voltage_path;
+    long trace_id;		// Index of the packet in the trace, NOT_VALID if not replayed
+    TransactionType transaction_type;
+    long transaction_id;	// Request number of the requester, for requests and replies
 
     // Constructors
-    Packet() { }
+    Packet() {
+	traffic_class = 0;
+	trace_id = NOT_VALID;
+	transaction_type = TRANSACTION_NONE;
+	transaction_id = NOT_VALID;
+    }
 
     Packet(const int s, const int d, const int vc, const double ts, const int sz) {
 	make(s, d, vc, ts, sz);
@@ -62,6 +84,11 @@ struct Packet {
 	size = sz;
 	flit_left = sz;
 	use_low_voltage_path = false;
+	dst_set.reset();
+	traffic_class = 0;
+	trace_id = NOT_VALID;
+	transaction_type = TRANSACTION_NONE;
+	transaction_id = NOT_VALID;
     }
 };
 
@@ -72,6 +99,7 @@ struct RouteData {
     int dst_id;
     int dir_in;			// direction from which the packet comes from
     int vc_id;
+    int traffic_class;
 };
 
 struct ChannelStatus {
@@ -84,10 +112,20 @@ struct ChannelStatus {
 
 // NoP_data -- NoP Data definition
 struct NoP_data {
+    NoP_data()
+    {
+	for (int i = 0; i < DIRECTIONS; i++)
+	    regional_free_slots[i] = NOT_VALID;
+    };
+
     int sender_id;
     ChannelStatus channel_status_neighbor[DIRECTIONS];
+    double regional_free_slots[DIRECTIONS];	// Congestion along each direction, RCA selection only
 
     inline bool operator ==(const NoP_data & nop_data) const {
+	for (int i = 0; i < DIRECTIONS; i++)
+	    if (regional_free_slots[i] != nop_data.regional_free_slots[i])
+		return false;
 	return (sender_id == nop_data.sender_id &&
 		nop_data.channel_status_neighbor[0] ==
 		channel_status_neighbor[0]
@@ -103,40 +141,59 @@ struct NoP_data {
 struct TBufferFullStatus {
     TBufferFullStatus()
     {
-	for (int i=0;i<MAX_VIRTUAL_CHANNELS;i++)
+	for (int i=0;i<MAX_VIRTUAL_CHANNELS;i++) {
 	    mask[i] = false;
+	    free_slots[i] = 0;
+	    credits[i] = 0;
+	}
+	gated = false;
     };
     inline bool operator ==(const TBufferFullStatus & bfs) const {
 	for (int i=0;i<MAX_VIRTUAL_CHANNELS;i++)
-	    if (mask[i] != bfs.mask[i]) return false;
-	return true;
+	    if (mask[i] != bfs.mask[i] || free_slots[i] != bfs.free_slots[i] ||
+		credits[i] != bfs.credits[i]) return false;
+	return gated == bfs.gated;
     };
    
     bool mask[MAX_VIRTUAL_CHANNELS];
+    int free_slots[MAX_VIRTUAL_CHANNELS];	// Free slots of each VC, used by VC allocation
+    int credits[MAX_VIRTUAL_CHANNELS];		// Flits removed from each VC since reset, i.e.
+						// credits returned by credit-based flow control
+    bool gated;					// Receiver powered off or waking up, flits are held
 };
 
 // Flit -- Flit definition
 struct Flit {
     int src_id;
-    int dst_id;
+    int dst_id;			// NOT_VALID for multicast flits, up to their delivery
+    CoreSet dst_set;		// Multicast destinations reached through this copy
     int vc_id; // Virtual Channel
+    int traffic_class;
     FlitType flit_type;	// The flit type (FLIT_TYPE_HEAD, FLIT_TYPE_BODY, FLIT_TYPE_TAIL)
     int sequence_no;		// The sequence number of the flit inside the packet
     int sequence_length;
     Payload payload;	// Optional payload
     double timestamp;		// Unix timestamp at packet generation
+    double injection_timestamp;	// Time at which the flit left the source queue
     int hop_no;			// Current number of hops from source to destination
+    double arrival_cycle;	// Cycle of arrival in the input buffer of the current router
     bool use_low_voltage_path;
+    long trace_id;		// Index of the packet in the trace, NOT_VALID if not replayed
+    TransactionType transaction_type;
+    long transaction_id;
 
     int hub_relay_node;
 
     inline bool operator ==(const Flit & flit) const {
 	return (flit.src_id == src_id && flit.dst_id == dst_id
+		&& flit.dst_set == dst_set
 		&& flit.flit_type == flit_type
 		&& flit.vc_id == vc_id
+		&& flit.traffic_class == traffic_class
 		&& flit.sequence_no == sequence_no
 		&& flit.sequence_length == sequence_length
 		&& flit.payload == payload && flit.timestamp == timestamp
+		&& flit.injection_timestamp == injection_timestamp
 		&& flit.hop_no == hop_no
 		&& flit.use_low_voltage_path == use_low_voltage_path);
 }};
@@ -169,6 +226,7 @@ enum
     LINK_R2R_PWR_D,
     LINK_R2H_PWR_D,
     NI_PWR_D,
+    ROUTER_WAKEUP_PWR_D,
     WIRELESS_TX,
     WIRELESS_DYNAMIC_RX_PWR,
     WIRELESS_SNOOPING,
@@ -0,0 +1,251 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the global deadlock detector
+ */
+
+#include <algorithm>
+#include "DeadlockDetector.h"
+#include "NoC.h"
+
+DeadlockDetector::DeadlockDetector(NoC * _noc)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    int n = 0;
+
+    noc = _noc;
+    for (int id = 0; id < graph->size(); id++) {
+	first_channel.push_back(n);
+	n += graph->getRadix(id) * GlobalParams::n_virtual_channels;
+    }
+    first_channel.push_back(n);
+
+    occupied.assign(n, false);
+    pops.assign(n, 0);
+}
+
+int DeadlockDetector::channel(const int node, const int port, const int vc) const
+{
+    return first_channel[node] + port * GlobalParams::n_virtual_channels + vc;
+}
+
+bool DeadlockDetector::check(ostream & out)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    int n_channels = first_channel.back();
+    vector < bool > deadlocked(n_channels, false);
+    vector < vector < int > > waits(n_channels);	// Channels each one waits for
+    vector < vector < int > > waited_by(n_channels);
+    bool stuck_any = false;
+
+    for (int id = 0; id < graph->size(); id++) {
+	Router * r = noc->node[id]->r;
+
+	for (int i = 0; i < r->n_ports; i++) {
+	    if (i == DIRECTION_HUB)
+		continue;
+
+	    for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++) {
+		int c = channel(id, i, vc);
+		bool stuck = !r->buffer[i][vc].IsEmpty() && occupied[c] &&
+		    pops[c] == (unsigned long) r->credits_freed[i][vc];
+
+		occupied[c] = !r->buffer[i][vc].IsEmpty();
+		pops[c] = r->credits_freed[i][vc];
+
+		if (!stuck)
+		    continue;
+
+		if (waitedChannels(id, i, vc, waits[c])) {
+		    deadlocked[c] = true;
+		    stuck_any = true;
+		}
+		else
+		    waits[c].clear();
+	    }
+	}
+    }
+
+    if (!stuck_any)
+	return false;
+
+    // Channels waiting for one which makes progress are not deadlocked
+    vector < int > live;
+
+    for (int c = 0; c < n_channels; c++) {
+	for (unsigned int k = 0; k < waits[c].size(); k++)
+	    waited_by[waits[c][k]].push_back(c);
+	if (!deadlocked[c])
+	    live.push_back(c);
+    }
+
+    while (!live.empty()) {
+	int c = live.back();
+	live.pop_back();
+
+	for (unsigned int k = 0; k < waited_by[c].size(); k++)
+	    if (deadlocked[waited_by[c][k]]) {
+		deadlocked[waited_by[c][k]] = false;
+		live.push_back(waited_by[c][k]);
+	    }
+    }
+
+    int first = NOT_VALID;
+    int count = 0;
+
+    for (int c = 0; c < n_channels; c++)
+	if (deadlocked[c]) {
+	    if (first == NOT_VALID)
+		first = c;
+	    count++;
+	}
+
+    if (first == NOT_VALID)
+	return false;
+
+    // Every deadlocked channel only waits for deadlocked ones: walking
+    // through them sooner or later gets back to a channel of the path
+    vector < int > path;
+    vector < int > position(n_channels, NOT_VALID);
+    int c = first;
+
+    while (position[c] == NOT_VALID) {
+	position[c] = path.size();
+	path.push_back(c);
+
+	unsigned int k = 0;
+	while (!deadlocked[waits[c][k]])
+	    k++;
+	c = waits[c][k];
+    }
+
+    out << count << " deadlocked channels, cycle of the wait-for graph:" << endl;
+    for (unsigned int k = position[c]; k < path.size(); k++)
+	describe(out, path[k]);
+
+    return true;
+}
+
+bool DeadlockDetector::waitedChannels(const int node, const int port, const int vc, vector < int > & targets) const
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    Router * r = noc->node[node]->r;
+    const Flit & flit = r->buffer[port][vc].Front();
+    int o, out_vc;
+
+    RouteData route_data;
+    route_data.current_id = node;
+    route_data.src_id = graph->getCoreNode(flit.src_id);
+    route_data.dir_in = port;
+    route_data.vc_id = vc;
+    route_data.traffic_class = flit.traffic_class;
+
+    // A multicast flit waits for the branches which can not take it. They
+    // are taken as alternatives: some deadlocks may be missed, but no
+    // false ones reported
+    const vector < MulticastBranch > & tree = r->multicast_tree[port][vc];
+
+    for (unsigned int b = 0; b < tree.size(); b++) {
+	o = tree[b].output;
+
+	if (r->canSend(o, tree[b].out_vc))
+	    continue;
+
+	if (r->isLocalPort(o))
+	    return false;
+
+	const TopologyLink & l = graph->getLinks()[graph->getNode(node).out_link[o]];
+	targets.push_back(channel(l.dst_id, l.dst_port, tree[b].out_vc));
+    }
+
+    if (!tree.empty())
+	return !targets.empty();
+
+    if (r->reservation_table.getReservation(port, vc, o, out_vc)) {
+	// Cores and hubs eventually take the flits
+	if (r->isLocalPort(o) || o == DIRECTION_HUB)
+	    return false;
+
+	const TopologyLink & l = graph->getLinks()[graph->getNode(node).out_link[o]];
+	targets.push_back(channel(l.dst_id, l.dst_port, out_vc));
+	return true;
+    }
+
+    // Multicast heads wait for outputs and room together, they are not
+    // followed
+    if (flit.flit_type != FLIT_TYPE_HEAD || flit.dst_id == NOT_VALID)
+	return false;
+
+    route_data.dst_id = graph->getCoreNode(flit.dst_id);
+
+    if (route_data.dst_id == node)
+	return false;
+
+    vector < int > outputs = r->routingFunction(route_data);
+    int escape = r->routingAlgorithm->escapeDirection(route_data);
+
+    if (escape != NOT_VALID)
+	outputs.push_back(escape);
+
+    // The head waits for any of the output VCs it may take to be released
+    for (unsigned int k = 0; k < outputs.size(); k++)
+	if (!outputHolders(node, route_data, outputs[k], targets))
+	    return false;
+
+    return !targets.empty();
+}
+
+bool DeadlockDetector::outputHolders(const int node, const RouteData & route_data, const int o, vector < int > & targets) const
+{
+    Router * r = noc->node[node]->r;
+
+    if (o == DIRECTION_HUB || o >= DIRECTION_HUB_RELAY)
+	return false;
+
+    int first, count;
+    if (r->dynamic_vcs)
+	r->outputVirtualChannels(route_data, o, first, count);
+    else {
+	first = r->outputVirtualChannel(route_data, o);
+	count = 1;
+    }
+
+    const vector < TReservation > & reservations = r->reservation_table.getOutputReservations(o);
+
+    for (int v = first; v < first + count; v++) {
+	int holder = NOT_VALID;
+
+	for (unsigned int h = 0; h < reservations.size(); h++)
+	    if (reservations[h].out_vc == v)
+		holder = channel(node, reservations[h].input, reservations[h].vc);
+
+	if (holder == NOT_VALID)
+	    return false;
+
+	targets.push_back(holder);
+    }
+
+    return true;
+}
+
+void DeadlockDetector::describe(ostream & out, const int c) const
+{
+    int node = upper_bound(first_channel.begin(), first_channel.end(), c) - first_channel.begin() - 1;
+    int port = (c - first_channel[node]) / GlobalParams::n_virtual_channels;
+    int vc = (c - first_channel[node]) % GlobalParams::n_virtual_channels;
+    Router * r = noc->node[node]->r;
+    int o, out_vc;
+
+    out << "  Router " << node << " Input[" << port << "][" << vc << "] "
+	<< r->buffer[port][vc].Size() << " flits, front " << r->buffer[port][vc].Front();
+
+    if (r->reservation_table.getReservation(port, vc, o, out_vc))
+	out << " -> Output[" << o << "][" << out_vc << "]";
+    else
+	out << " waiting for an output VC";
+    out << endl;
+}
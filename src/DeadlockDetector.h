@@ -0,0 +1,60 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the global deadlock detector
+ */
+
+#ifndef __NOXIMDEADLOCKDETECTOR_H__
+#define __NOXIMDEADLOCKDETECTOR_H__
+
+#include <iostream>
+#include <vector>
+#include "DataStructs.h"
+
+using namespace std;
+
+class NoC;
+
+// DeadlockDetector -- builds the wait-for graph of the router input
+// channels (port and VC) and looks for a set of channels which can not
+// make progress. A channel is stuck if it has held flits since the
+// previous check without any of them leaving. Its front packet waits for
+// room in the downstream channel, if it holds a reservation, or else
+// for the packets holding the output VCs it may be assigned. A stuck
+// channel is deadlocked if all the channels it waits for are: they
+// always include a cycle
+class DeadlockDetector {
+
+  public:
+
+    DeadlockDetector(NoC * _noc);
+
+    // Updates the state of the channels and reports the deadlocked ones,
+    // if any. Channels need to be stuck at two consecutive checks
+    bool check(ostream & out);
+
+  private:
+
+    NoC * noc;
+    vector < int > first_channel;	// Index of the first channel of each node
+    vector < bool > occupied;		// Channel holding flits at the previous check
+    vector < unsigned long > pops;	// Flits left the channel up to the previous check
+
+    int channel(const int node, const int port, const int vc) const;
+
+    // Channels the front packet of node.port.vc waits for. False if it
+    // may move once the router arbitrates, whatever the other channels
+    bool waitedChannels(const int node, const int port, const int vc, vector < int > & targets) const;
+
+    // Adds the channels holding the VCs of output o a head may take.
+    // False if any of them is free
+    bool outputHolders(const int node, const RouteData & route_data, const int o, vector < int > & targets) const;
+
+    void describe(ostream & out, const int c) const;
+};
+
+#endif
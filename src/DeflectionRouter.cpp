@@ -0,0 +1,215 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the bufferless deflection router
+ */
+
+#include <algorithm>
+#include "DeflectionRouter.h"
+
+static bool olderFirst(const DeflectionCandidate & a, const DeflectionCandidate & b)
+{
+    // Packets are told apart by source and generation time, their
+    // flits by sequence number: no two flits tie
+    if (a.flit.timestamp != b.flit.timestamp)
+	return a.flit.timestamp < b.flit.timestamp;
+    if (a.flit.src_id != b.flit.src_id)
+	return a.flit.src_id < b.flit.src_id;
+    return a.flit.sequence_no < b.flit.sequence_no;
+}
+
+static bool goldenFirst(const DeflectionCandidate & a, const DeflectionCandidate & b)
+{
+    if (a.golden != b.golden)
+	return a.golden;
+
+    return a.golden && olderFirst(a, b);
+}
+
+DeflectionRouter::DeflectionRouter(sc_module_name nm, const TopologyNode & tn) : Router(nm, tn.radix)
+{
+    // Every flit received must find an output in the next cycle
+    int in_ports = 0, out_ports = 0;
+
+    for (int p = 0; p < tn.radix; p++) {
+	in_ports += (tn.in_link[p] != NOT_VALID);
+	out_ports += (tn.out_link[p] != NOT_VALID);
+    }
+
+    if (in_ports > out_ports) {
+	cerr << "Error: deflection router of node " << tn.id << " has more input than output links" << endl;
+	exit(1);
+    }
+
+    deflected_flits = 0;
+}
+
+void DeflectionRouter::txProcess()
+{
+    if (reset.read()) {
+	Router::txProcess();
+	deflected_flits = 0;
+	return;
+    }
+
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    vector < bool > busy(n_ports, false);
+
+    // The flits latched in the previous cycle can not stay
+    vector < DeflectionCandidate > flits;
+
+    for (int i = 0; i < n_ports; i++) {
+	if (isLocalPort(i) || i == DIRECTION_HUB)
+	    continue;
+
+	for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+	    while (!buffer[i][vc].IsEmpty()) {
+		DeflectionCandidate c;
+		c.flit = buffer[i][vc].Pop();
+		c.input = i;
+		c.vc = vc;
+		flits.push_back(c);
+	    }
+    }
+
+    prioritize(flits, now);
+
+    for (unsigned int k = 0; k < flits.size(); k++) {
+	bool deflected;
+	int o = assignOutput(flits[k].flit, flits[k].input, busy, deflected);
+
+	assert(o != NOT_VALID);
+	busy[o] = true;
+	if (deflected)
+	    deflected_flits++;
+	forward(flits[k].flit, flits[k].input, o);
+    }
+
+    // Injection, in the outputs left free
+    for (int k = 0; k < n_local; k++) {
+	int i = local_port[k];
+
+	for (int j = 0; j < GlobalParams::n_virtual_channels; j++) {
+	    int vc = (start_from_vc[i] + j) % GlobalParams::n_virtual_channels;
+
+	    if (buffer[i][vc].IsEmpty())
+		continue;
+
+	    Flit flit = buffer[i][vc].Front();
+	    power.bufferRouterFront();
+
+	    bool deflected;
+	    int o = assignOutput(flit, i, busy, deflected);
+
+	    if (o == NOT_VALID)
+		continue;
+
+	    busy[o] = true;
+	    if (deflected)
+		deflected_flits++;
+
+	    buffer[i][vc].Pop();
+	    credits_freed[i][vc]++;
+	    power.bufferRouterPop();
+	    forward(flit, i, o);
+
+	    start_from_vc[i] = (vc + 1) % GlobalParams::n_virtual_channels;
+	    break;
+	}
+    }
+
+    start_from_port = (start_from_port + 1) % n_ports;
+}
+
+void DeflectionRouter::prioritize(vector < DeflectionCandidate > & flits, const double now) const
+{
+    if (GlobalParams::deflection_priority == DEFLECTION_OLDEST_FIRST) {
+	sort(flits.begin(), flits.end(), olderFirst);
+	return;
+    }
+
+    // The golden source changes every golden_epoch cycles. Its flits go
+    // first, oldest first, so that at any time one of them makes
+    // progress: the others are in random order
+    int golden_core = ((int) now / GlobalParams::golden_epoch) % TopologyGraph::getInstance()->getCoreCount();
+
+    for (int k = flits.size() - 1; k > 0; k--)
+	swap(flits[k], flits[rand() % (k + 1)]);
+
+    for (unsigned int k = 0; k < flits.size(); k++)
+	flits[k].golden = (flits[k].flit.src_id == golden_core);
+
+    stable_sort(flits.begin(), flits.end(), goldenFirst);
+}
+
+int DeflectionRouter::assignOutput(const Flit & flit, const int in, const vector < bool > & busy, bool & deflected)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+
+    deflected = false;
+
+    if (graph->getCoreNode(flit.dst_id) == local_id) {
+	int o = local_port[graph->getCoreIndex(flit.dst_id)];
+	if (!busy[o])
+	    return o;
+
+	// Flits injected for a core of the same router wait the ejection
+	if (isLocalPort(in))
+	    return NOT_VALID;
+    }
+    else {
+	RouteData route_data;
+	route_data.current_id = local_id;
+	route_data.src_id = graph->getCoreNode(flit.src_id);
+	route_data.dst_id = graph->getCoreNode(flit.dst_id);
+	route_data.dir_in = in;
+	route_data.vc_id = flit.vc_id;
+	route_data.traffic_class = flit.traffic_class;
+
+	power.routing();
+	vector < int > productive = routingFunction(route_data);
+
+	for (unsigned int k = 0; k < productive.size(); k++)
+	    if (!busy[productive[k]])
+		return productive[k];
+    }
+
+    // Any other output with a link, starting from a different one at
+    // each cycle not to always push flits the same way
+    deflected = true;
+    for (int k = 0; k < n_ports; k++) {
+	int o = (start_from_port + k) % n_ports;
+
+	if (!busy[o] && graph->isNetworkPort(local_id, o) && graph->hasOutput(local_id, o))
+	    return o;
+    }
+
+    return NOT_VALID;
+}
+
+void DeflectionRouter::forward(const Flit & flit, const int in, const int o)
+{
+    Flit f = flit;
+
+    LOG << "Input[" << in << "] forwarded to Output[" << o << "], flit: " << f << endl;
+
+    if (!isLocalPort(o))
+	f.hop_no++;
+    flit_tx[o].write(f);
+    tx_flits[o]++;
+    current_level_tx[o] = 1 - current_level_tx[o];
+    req_tx[o].write(current_level_tx[o]);
+
+    power.r2rLink(o);
+    power.crossBar();
+
+    // Statistics are taken by the PE, once the packet is reassembled
+    if (isLocalPort(o))
+	drainFlit(o, f);
+    else if (!isLocalPort(in))
+	routed_flits++;
+}
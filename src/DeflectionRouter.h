@@ -0,0 +1,61 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the bufferless deflection router
+ */
+
+#ifndef __NOXIMDEFLECTIONROUTER_H__
+#define __NOXIMDEFLECTIONROUTER_H__
+
+#include "Router.h"
+#include "TopologyGraph.h"
+
+using namespace std;
+
+// A flit competing for the outputs of a deflection router
+struct DeflectionCandidate {
+    Flit flit;
+    int input;			// Port the flit comes from
+    int vc;			// Injection VC, for flits of the local ports
+    bool golden;		// Belongs to the golden source
+};
+
+// DeflectionRouter -- bufferless router switching single flits
+// (BLESS/CHIPPER). The flits received on the network ports are held in a
+// pipeline register for one cycle and then all of them leave: in
+// priority order, each one takes a free productive output, i.e. one of
+// the routing function, or is deflected on any other free output. Cores
+// inject from the local queues while outputs are left, and packets are
+// reassembled by the destination PE, as flits may arrive in any order
+class DeflectionRouter : public Router {
+
+  public:
+
+    DeflectionRouter(sc_module_name nm, const TopologyNode & tn);
+
+    void txProcess();
+
+    // Only the injection queues of the local ports are buffers
+    bool hasInputBuffer(int port) const { return isLocalPort(port); }
+
+    unsigned long getDeflectedFlits() const { return deflected_flits; }
+
+  private:
+
+    unsigned long deflected_flits;	// Flits sent on a non productive output
+
+    // Sorts the flits from the highest priority one
+    void prioritize(vector < DeflectionCandidate > & flits, const double now) const;
+
+    // Free output for flit, productive one if any. deflected tells if it
+    // moves the flit away from its destination. NOT_VALID if none
+    int assignOutput(const Flit & flit, const int in, const vector < bool > & busy, bool & deflected);
+
+    void forward(const Flit & flit, const int in, const int o);
+};
+
+#endif
@@ -15,26 +15,89 @@ int GlobalParams::trace_mode;
 string GlobalParams::trace_filename;
 
 string GlobalParams::topology;
+string GlobalParams::topology_filename;
 
 int GlobalParams::mesh_dim_x;
 int GlobalParams::mesh_dim_y;
+int GlobalParams::mesh_dim_z;
+int GlobalParams::concentration;
+int GlobalParams::express_interval;
+int GlobalParams::chiplet_dim_x;
+int GlobalParams::chiplet_dim_y;
+int GlobalParams::interposer_links;
+double GlobalParams::interposer_link_length;
+int GlobalParams::interposer_link_latency;
+int GlobalParams::interposer_link_width;
 
 int GlobalParams::n_delta_tiles;
+int GlobalParams::delta_radix;
 
 double GlobalParams::r2r_link_length;
+int GlobalParams::r2r_link_latency;
+double GlobalParams::link_mm_per_cycle;
+double GlobalParams::vertical_link_length;
+int GlobalParams::vertical_link_latency;
 double GlobalParams::r2h_link_length;
 int GlobalParams::buffer_depth;
+string GlobalParams::flow_control;
+string GlobalParams::buffer_organization;
+int GlobalParams::damq_pool_size;
+int GlobalParams::damq_reserved;
+string GlobalParams::router_architecture;
+string GlobalParams::deflection_priority;
+int GlobalParams::golden_epoch;
+int GlobalParams::deadlock_check_period;
+string GlobalParams::power_gating;
+int GlobalParams::power_gating_timeout;
+int GlobalParams::power_gating_wakeup;
+double GlobalParams::power_gating_wakeup_energy;
+string GlobalParams::clock_domains;
+int GlobalParams::clock_region_size;
+int GlobalParams::cdc_sync_cycles;
+string GlobalParams::dvfs_levels;
+vector<pair<double, double> > GlobalParams::dvfs_level_table;
+string GlobalParams::dvfs_policy;
+int GlobalParams::dvfs_initial_level;
+int GlobalParams::dvfs_period;
+double GlobalParams::dvfs_up_threshold;
+double GlobalParams::dvfs_down_threshold;
+string GlobalParams::router_pipeline;
+bool GlobalParams::lookahead_routing;
+bool GlobalParams::speculative_allocation;
+int GlobalParams::pipeline_stage[PIPELINE_UNITS];
 int GlobalParams::flit_size;
 int GlobalParams::min_packet_size;
 int GlobalParams::max_packet_size;
 string GlobalParams::routing_algorithm;
 string GlobalParams::routing_table_filename;
 string GlobalParams::selection_strategy;
+string GlobalParams::switch_allocator;
+string GlobalParams::vc_allocation;
+string GlobalParams::traffic_class_vcs;
+vector<int> GlobalParams::class_vcs;
 double GlobalParams::packet_injection_rate;
 double GlobalParams::probability_of_retransmission;
 double GlobalParams::locality;
+int GlobalParams::source_queue_size;
+int GlobalParams::source_queue_vc_size;
+string GlobalParams::source_queue_policy;
+double GlobalParams::multicast_rate;
+int GlobalParams::multicast_destinations;
+string GlobalParams::multicast_replication;
+bool GlobalParams::request_reply;
+int GlobalParams::reply_packet_size;
+int GlobalParams::reply_service_time;
+int GlobalParams::max_outstanding_requests;
+string GlobalParams::memory_controllers;
+vector<int> GlobalParams::memory_controller_cores;
+int GlobalParams::memory_banks;
+int GlobalParams::memory_latency;
+double GlobalParams::memory_bandwidth;
+double GlobalParams::memory_traffic_ratio;
 string GlobalParams::traffic_distribution;
 string GlobalParams::traffic_table_filename;
+string GlobalParams::traffic_trace_filename;
+bool GlobalParams::trace_dependencies;
 string GlobalParams::config_filename;
 string GlobalParams::power_config_filename;
 int GlobalParams::clock_period_ps;
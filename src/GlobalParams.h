@@ -30,6 +30,15 @@ using namespace std;
 #define DIRECTION_WEST          3
 #define DIRECTION_LOCAL         4
 #define DIRECTION_HUB           5
+// First additional port of high-radix routers. Additional network
+// ports come first, then the local ports of the cores after the first one
+#define DIRECTION_EXTRA         6
+// Express channels of the mesh, one for each planar direction
+#define DIRECTION_EXPRESS(d)    (DIRECTION_EXTRA + (d))
+// Vertical ports of 3D meshes, UP towards higher layers
+#define DIRECTION_UP            (DIRECTION_EXTRA)
+#define DIRECTION_DOWN          (DIRECTION_EXTRA + 1)
+#define MAX_CONCENTRATION       4
 #define DIRECTION_HUB_RELAY     5000
 #define DIRECTION_WIRELESS    747
 
@@ -49,14 +58,28 @@ using namespace std;
 
 //Topologies
 #define TOPOLOGY_MESH          "MESH"
+// Meshes with wraparound links
+#define TOPOLOGY_TORUS         "TORUS"
+#define TOPOLOGY_FOLDED_TORUS  "FOLDED_TORUS"
+// Mesh with several cores attached to each router
+#define TOPOLOGY_CMESH         "CMESH"
+#define TOPOLOGY_MESH3D        "MESH3D"
+// Meshes (chiplets) connected by a few interposer links
+#define TOPOLOGY_CHIPLET       "CHIPLET"
 //Delta Networks Topologies
 #define TOPOLOGY_BASELINE      "BASELINE"
 #define TOPOLOGY_BUTTERFLY     "BUTTERFLY"
 #define TOPOLOGY_OMEGA         "OMEGA"
+// Graph described in topology_filename
+#define TOPOLOGY_CUSTOM        "CUSTOM"
 
 // Routing algorithms
 #define ROUTING_DYAD           "DYAD"
 #define ROUTING_TABLE_BASED    "TABLE_BASED"
+#define ROUTING_TORUS_XY       "TORUS_XY"
+#define ROUTING_EXPRESS_XY     "EXPRESS_XY"
+#define ROUTING_CHIPLET_XY     "CHIPLET_XY"
+#define ROUTING_DUATO          "DUATO"
 
 
 // Channel selection 
@@ -74,6 +97,68 @@ using namespace std;
 #define TRAFFIC_BUTTERFLY      "TRAFFIC_BUTTERFLY"
 #define TRAFFIC_LOCAL	       "TRAFFIC_LOCAL"
 #define TRAFFIC_ULOCAL	       "TRAFFIC_ULOCAL"
+#define TRAFFIC_TRACE	       "TRAFFIC_TRACE"
+
+// Source queue policies (what a PE does when its injection queue is full)
+#define SOURCE_QUEUE_STALL     "STALL"
+#define SOURCE_QUEUE_DROP      "DROP"
+
+// Multicast packets are replicated along a tree by the routers, or
+// sent by the source PE as one unicast packet for each destination
+#define MULTICAST_ROUTER       "ROUTER"
+#define MULTICAST_SOURCE       "SOURCE"
+// Largest core count supported by multicast destination sets
+#define MAX_MULTICAST_CORES    256
+
+// Virtual channel allocation: VC fixed at injection (and moved only
+// across VC classes) or chosen by the router at each hop
+#define VC_ALLOCATION_STATIC   "STATIC"
+#define VC_ALLOCATION_DYNAMIC  "DYNAMIC"
+
+// Organization of the router input buffers: buffer_depth slots for
+// each VC, or a pool of slots shared by the VCs of the port
+#define BUFFER_ORGANIZATION_PRIVATE "PRIVATE"
+#define BUFFER_ORGANIZATION_DAMQ    "DAMQ"
+
+// Router architectures: input buffered with wormhole switching, or
+// bufferless, with the flits losing port arbitration deflected
+#define ROUTER_BUFFERED        "BUFFERED"
+#define ROUTER_DEFLECTION      "DEFLECTION"
+
+// Arbitration of deflection routers: oldest flit first, or flits of
+// the golden packets first and random order among the others
+#define DEFLECTION_OLDEST_FIRST "OLDEST_FIRST"
+#define DEFLECTION_GOLDEN       "GOLDEN"
+
+// Router power gating: none, after a fixed idle timeout, or when the
+// idle period predicted from the past ones exceeds the break-even time
+#define POWER_GATING_NONE      "NONE"
+#define POWER_GATING_TIMEOUT   "TIMEOUT"
+#define POWER_GATING_BREAK_EVEN "BREAK_EVEN"
+
+// Clock domains of the routers: a single one, one for each router, or
+// one for each square region of routers
+#define CLOCK_DOMAINS_NONE     "NONE"
+#define CLOCK_DOMAINS_ROUTER   "ROUTER"
+#define CLOCK_DOMAINS_REGION   "REGION"
+
+// DVFS policies: clock domains keep their level, or move to a faster
+// (slower) one when their utilization is above (below) a threshold
+#define DVFS_STATIC            "STATIC"
+#define DVFS_UTILIZATION       "UTILIZATION"
+
+// Link level flow control: alternating bit handshake, one flit in
+// flight per link, or credits counting the free slots downstream
+#define FLOW_CONTROL_ABP       "ABP"
+#define FLOW_CONTROL_CREDIT    "CREDIT"
+
+// Units of the router pipeline: route computation, VC allocation,
+// switch allocation and switch traversal
+#define PIPELINE_RC            0
+#define PIPELINE_VA            1
+#define PIPELINE_SA            2
+#define PIPELINE_ST            3
+#define PIPELINE_UNITS         4
 
 // Verbosity levels
 #define VERBOSE_OFF            "VERBOSE_OFF"
@@ -134,6 +219,8 @@ typedef struct {
 typedef struct {
     BufferPowerConfig bufferPowerConfig;
     LinkBitLinePowerConfig linkBitLinePowerConfig;
+    bool hasVerticalLinkBitLine;
+    pair<double, double> verticalLinkBitLinePowerConfig;	// [Leakage, Dynamic] of a TSV
     RouterPowerConfig routerPowerConfig;
     HubPowerConfig hubPowerConfig;
 } PowerConfig;
@@ -143,23 +230,86 @@ struct GlobalParams {
     static int trace_mode;
     static string trace_filename;
     static string topology;
+    static string topology_filename;
     static int mesh_dim_x;
     static int mesh_dim_y;
+    static int mesh_dim_z;
+    static int concentration;
+    static int express_interval;
+    static int chiplet_dim_x;
+    static int chiplet_dim_y;
+    static int interposer_links;
+    static double interposer_link_length;
+    static int interposer_link_latency;
+    static int interposer_link_width;
     static int n_delta_tiles;
+    static int delta_radix;
     static double r2r_link_length;
+    static int r2r_link_latency;
+    static double link_mm_per_cycle;
+    static double vertical_link_length;
+    static int vertical_link_latency;
     static double r2h_link_length;
     static int buffer_depth;
+    static string flow_control;
+    static string buffer_organization;
+    static int damq_pool_size;
+    static int damq_reserved;
+    static string router_architecture;
+    static string deflection_priority;
+    static int golden_epoch;
+    static int deadlock_check_period;
+    static string power_gating;
+    static int power_gating_timeout;
+    static int power_gating_wakeup;
+    static double power_gating_wakeup_energy;
+    static string clock_domains;
+    static int clock_region_size;
+    static int cdc_sync_cycles;
+    static string dvfs_levels;
+    static vector<pair<double, double> > dvfs_level_table;	// Frequency and voltage of each level, from dvfs_levels
+    static string dvfs_policy;
+    static int dvfs_initial_level;
+    static int dvfs_period;
+    static double dvfs_up_threshold;
+    static double dvfs_down_threshold;
+    static string router_pipeline;
+    static bool lookahead_routing;
+    static bool speculative_allocation;
+    static int pipeline_stage[PIPELINE_UNITS];	// Stage (cycle) completing each unit, 0 if none
     static int flit_size;
     static int min_packet_size;
     static int max_packet_size;
     static string routing_algorithm;
     static string routing_table_filename;
     static string selection_strategy;
+    static string switch_allocator;
+    static string vc_allocation;
+    static string traffic_class_vcs;
+    static vector<int> class_vcs;	// VCs of each traffic class, from traffic_class_vcs
     static double packet_injection_rate;
     static double probability_of_retransmission;
     static double locality;
+    static int source_queue_size;
+    static int source_queue_vc_size;
+    static string source_queue_policy;
+    static double multicast_rate;
+    static int multicast_destinations;
+    static string multicast_replication;
+    static bool request_reply;
+    static int reply_packet_size;
+    static int reply_service_time;
+    static int max_outstanding_requests;
+    static string memory_controllers;
+    static vector<int> memory_controller_cores;	// Cores replaced by memory controllers, from memory_controllers
+    static int memory_banks;
+    static int memory_latency;
+    static double memory_bandwidth;
+    static double memory_traffic_ratio;
     static string traffic_distribution;
     static string traffic_table_filename;
+    static string traffic_trace_filename;
+    static bool trace_dependencies;
     static string config_filename;
     static string power_config_filename;
     static int clock_period_ps;
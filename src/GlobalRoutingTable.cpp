@@ -9,37 +9,17 @@
  */
 
 #include "GlobalRoutingTable.h"
+#include "TopologyGraph.h"
 using namespace std;
 
 LinkId direction2ILinkId(const int node_id, const int dir)
 {
     int node_src;
 
-    switch (dir) {
-    case DIRECTION_NORTH:
-	node_src = node_id - GlobalParams::mesh_dim_x;
-	break;
-
-    case DIRECTION_SOUTH:
-	node_src = node_id + GlobalParams::mesh_dim_x;
-	break;
-
-    case DIRECTION_EAST:
-	node_src = node_id + 1;
-	break;
-
-    case DIRECTION_WEST:
-	node_src = node_id - 1;
-	break;
-
-    case DIRECTION_LOCAL:
+    if (dir == DIRECTION_LOCAL)
 	node_src = node_id;
-	break;
-
-    default:
-	assert(false);
-    }
-
+    else
+	node_src = TopologyGraph::getInstance()->getInputNeighbor(node_id, dir);
 
     return LinkId(node_src, node_id);
 }
@@ -51,17 +31,12 @@ int oLinkId2Direction(const LinkId & out_link)
 
     if (dst == src)
 	return DIRECTION_LOCAL;
-    else if (dst == src + 1)
-	return DIRECTION_EAST;
-    else if (dst == src - 1)
-	return DIRECTION_WEST;
-    else if (dst == src - GlobalParams::mesh_dim_x)
-	return DIRECTION_NORTH;
-    else if (dst == src + GlobalParams::mesh_dim_x)
-	return DIRECTION_SOUTH;
-    else
-	assert(false);
-    return 0;
+
+    int dir = TopologyGraph::getInstance()->getPort(src, dst);
+
+    assert(dir != NOT_VALID);
+
+    return dir;
 }
 
 vector <
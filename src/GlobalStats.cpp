@@ -25,42 +25,20 @@ double GlobalStats::getAverageDelay()
     unsigned int total_packets = 0;
     double avg_delay = 0.0;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
     {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
-	    {
-		unsigned int received_packets =
-		    noc->t[x][y]->r->stats.getReceivedPackets();
-
-		if (received_packets) 
-		{
-		    avg_delay +=
-			received_packets *
-			noc->t[x][y]->r->stats.getAverageDelay();
-		    total_packets += received_packets;
-		}
-	    }
-    }
-    else // other delta topologies
-    { 
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	{
-	    unsigned int received_packets =
-		noc->core[y]->r->stats.getReceivedPackets();
+	unsigned int received_packets =
+	    noc->getCoreStats(i).getReceivedPackets();
 
-	    if (received_packets) 
-	    {
-		avg_delay +=
-		    received_packets *
-		    noc->core[y]->r->stats.getAverageDelay();
-		total_packets += received_packets;
-	    }
+	if (received_packets) 
+	{
+	    avg_delay +=
+		received_packets *
+		noc->getCoreStats(i).getAverageDelay();
+	    total_packets += received_packets;
 	}
-
     }
 
-
     avg_delay /= (double) total_packets;
 
     return avg_delay;
@@ -68,100 +46,272 @@ double GlobalStats::getAverageDelay()
 
 
 
-double GlobalStats::getAverageDelay(const int src_id,
-					 const int dst_id)
+double GlobalStats::getAverageNetworkDelay()
 {
-    Tile *tile = noc->searchNode(dst_id);
+    unsigned int total_packets = 0;
+    double avg_delay = 0.0;
 
-    assert(tile != NULL);
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+    {
+	unsigned int received_packets =
+	    noc->getCoreStats(i).getReceivedPackets();
 
-    return tile->r->stats.getAverageDelay(src_id);
+	if (received_packets) 
+	{
+	    avg_delay +=
+		received_packets *
+		noc->getCoreStats(i).getAverageNetworkDelay();
+	    total_packets += received_packets;
+	}
+    }
+
+    if (total_packets == 0)
+	return -1.0;
+
+    avg_delay /= (double) total_packets;
+
+    return avg_delay;
 }
 
-double GlobalStats::getMaxDelay()
+double GlobalStats::getAverageHops()
 {
-    double maxd = -1.0;
+    unsigned int total_packets = 0;
+    double avg_hops = 0.0;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
     {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
-	    {
-		Coord coord;
-		coord.x = x;
-		coord.y = y;
-		int node_id = coord2Id(coord);
-		double d = getMaxDelay(node_id);
-		if (d > maxd)
-		    maxd = d;
-	    }
+	unsigned int received_packets =
+	    noc->getCoreStats(i).getReceivedPackets();
 
-    }
-    else  // other delta topologies 
-    {
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
+	if (received_packets) 
 	{
-	    double d = getMaxDelay(y);
-	    if (d > maxd)
-		maxd = d;
+	    avg_hops +=
+		received_packets *
+		noc->getCoreStats(i).getAverageHops();
+	    total_packets += received_packets;
 	}
     }
 
-    return maxd;
+    if (total_packets == 0)
+	return -1.0;
+
+    avg_hops /= (double) total_packets;
+
+    return avg_hops;
 }
 
-double GlobalStats::getMaxDelay(const int node_id)
+vector < ProcessingElement * > GlobalStats::getProcessingElements()
+{
+    vector < ProcessingElement * > pes;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	pes.push_back(noc->getCorePE(i));
+
+    return pes;
+}
+
+double GlobalStats::getAverageSourceQueueDelay()
 {
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long samples = 0;
+    double total_delay = 0.0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
     {
-	Coord coord = id2Coord(node_id);
+	samples += pes[i]->source_delay_samples;
+	total_delay += pes[i]->total_source_delay;
+    }
 
-	unsigned int received_packets =
-	    noc->t[coord.x][coord.y]->r->stats.getReceivedPackets();
+    if (samples == 0)
+	return -1.0;
+
+    return total_delay / (double) samples;
+}
+
+double GlobalStats::getMaxSourceQueueDelay()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long samples = 0;
+    double maxd = 0.0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	samples += pes[i]->source_delay_samples;
+
+    if (samples == 0)
+	return -1.0;
 
-	if (received_packets)
-	    return noc->t[coord.x][coord.y]->r->stats.getMaxDelay();
-	else
-	    return -1.0;
+    for (unsigned int i = 0; i < pes.size(); i++)
+	if (pes[i]->max_source_delay > maxd)
+	    maxd = pes[i]->max_source_delay;
+
+    return maxd;
+}
+
+unsigned long GlobalStats::getCompletedTransactions()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long n = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	n += pes[i]->completed_transactions;
+
+    return n;
+}
+
+double GlobalStats::getAverageTransactionDelay()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long transactions = getCompletedTransactions();
+    double total_delay = 0.0;
+
+    if (transactions == 0)
+	return -1.0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	total_delay += pes[i]->total_transaction_delay;
+
+    return total_delay / (double) transactions;
+}
+
+double GlobalStats::getMaxTransactionDelay()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    double maxd = 0.0;
+
+    if (getCompletedTransactions() == 0)
+	return -1.0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	if (pes[i]->max_transaction_delay > maxd)
+	    maxd = pes[i]->max_transaction_delay;
+
+    return maxd;
+}
+
+void GlobalStats::showMemoryControllerStats(std::ostream & out)
+{
+    double total_cycles = GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
+
+    // Per controller, to compare the placements
+    for (unsigned int k = 0; k < GlobalParams::memory_controller_cores.size(); k++) {
+	int core = GlobalParams::memory_controller_cores[k];
+	MemoryController * mc = (MemoryController *) noc->getCorePE(core);
+	double service_delay = -1.0;
+
+	if (mc->served_requests > 0)
+	    service_delay = mc->total_service_delay / mc->served_requests;
+
+	out << "% Memory controller " << core << ": served " << mc->served_requests
+	    << ", average service delay (cycles) " << service_delay
+	    << ", bank utilization " << mc->bank_busy_cycles / (GlobalParams::memory_banks * total_cycles)
+	    << ", bus utilization " << mc->bus_busy_cycles / total_cycles
+	    << ", max queued requests " << mc->max_queued_requests << endl;
     }
-    else // other delta topologies
+}
+
+double GlobalStats::getOfferedLoad()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    int total_cycles = GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
+    unsigned long flits = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	flits += pes[i]->offered_flits;
+
+    return (double) flits / (double) total_cycles / (double) pes.size();
+}
+
+double GlobalStats::getAcceptedLoad()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    int total_cycles = GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
+    unsigned long flits = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	flits += pes[i]->injected_flits;
+
+    return (double) flits / (double) total_cycles / (double) pes.size();
+}
+
+unsigned long GlobalStats::getDroppedPackets()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long n = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	n += pes[i]->dropped_packets;
+
+    return n;
+}
+
+unsigned long GlobalStats::getTracePacketsLeft()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    unsigned long n = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	n += pes[i]->trace_cursor.left() + pes[i]->trace_waiting.size();
+
+    return n;
+}
+
+double GlobalStats::getAverageDelay(const int src_id,
+					 const int dst_id)
+{
+    assert(dst_id >= 0 && dst_id < TopologyGraph::getInstance()->getCoreCount());
+
+    return noc->getCoreStats(dst_id).getAverageDelay(src_id);
+}
+
+double GlobalStats::getMaxDelay()
+{
+    double maxd = -1.0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
     {
-	unsigned int received_packets =
-	    noc->core[node_id]->r->stats.getReceivedPackets();
-	if (received_packets)
-	    return noc->core[node_id]->r->stats.getMaxDelay();
-	else
-	    return -1.0;
+	double d = getMaxDelay(i);
+	if (d > maxd)
+	    maxd = d;
     }
 
+    return maxd;
 }
 
-double GlobalStats::getMaxDelay(const int src_id, const int dst_id)
+double GlobalStats::getMaxDelay(const int node_id)
 {
-    Tile *tile = noc->searchNode(dst_id);
+    unsigned int received_packets =
+	noc->getCoreStats(node_id).getReceivedPackets();
+
+    if (received_packets)
+	return noc->getCoreStats(node_id).getMaxDelay();
+    else
+	return -1.0;
+}
 
-    assert(tile != NULL);
+double GlobalStats::getMaxDelay(const int src_id, const int dst_id)
+{
+    assert(dst_id >= 0 && dst_id < TopologyGraph::getInstance()->getCoreCount());
 
-    return tile->r->stats.getMaxDelay(src_id);
+    return noc->getCoreStats(dst_id).getMaxDelay(src_id);
 }
 
 vector < vector < double > > GlobalStats::getMaxDelayMtx()
 {
     vector < vector < double > > mtx;
 
-    assert(GlobalParams::topology == TOPOLOGY_MESH); 
+    assert(isMeshTopology()); 
 
-    mtx.resize(GlobalParams::mesh_dim_y);
-    for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	mtx[y].resize(GlobalParams::mesh_dim_x);
+    mtx.resize(coreDimY());
+    for (int y = 0; y < coreDimY(); y++)
+	mtx[y].resize(coreDimX());
 
-    for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
+    for (int y = 0; y < coreDimY(); y++)
+	for (int x = 0; x < coreDimX(); x++) 
 	{
 	    Coord coord;
 	    coord.x = x;
 	    coord.y = y;
-	    int id = coord2Id(coord);
+	    int id = coreCoord2Id(coord);
 	    mtx[y][x] = getMaxDelay(id);
 	}
 
@@ -170,11 +320,9 @@ vector < vector < double > > GlobalStats::getMaxDelayMtx()
 
 double GlobalStats::getAverageThroughput(const int src_id, const int dst_id)
 {
-    Tile *tile = noc->searchNode(dst_id);
+    assert(dst_id >= 0 && dst_id < TopologyGraph::getInstance()->getCoreCount());
 
-    assert(tile != NULL);
-
-    return tile->r->stats.getAverageThroughput(src_id);
+    return noc->getCoreStats(dst_id).getAverageThroughput(src_id);
 }
 
 /*
@@ -212,17 +360,8 @@ unsigned int GlobalStats::getReceivedPackets()
 {
     unsigned int n = 0;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-    	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-		for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    n += noc->t[x][y]->r->stats.getReceivedPackets();
-    }
-    else // other delta topologies
-    {
-    	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	    n += noc->core[y]->r->stats.getReceivedPackets();
-    }
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	n += noc->getCoreStats(i).getReceivedPackets();
 
     return n;
 }
@@ -230,42 +369,184 @@ unsigned int GlobalStats::getReceivedPackets()
 unsigned int GlobalStats::getReceivedFlits()
 {
     unsigned int n = 0;
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) {
-		n += noc->t[x][y]->r->stats.getReceivedFlits();
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	n += noc->getCoreStats(i).getReceivedFlits();
+
 #ifdef TESTING
-		drained_total += noc->t[x][y]->r->local_drained;
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	if (!TopologyGraph::getInstance()->getNode(i).cores.empty())
+	    drained_total += noc->node[i]->r->local_drained;
 #endif
-	    }
+
+    return n;
+}
+
+double GlobalStats::getMatchingEfficiency()
+{
+    unsigned long matched = 0;
+    unsigned long max_matching = 0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++) {
+	matched += noc->node[i]->r->sa_matched;
+	max_matching += noc->node[i]->r->sa_max_matching;
     }
-    else // other delta topologies
-    {
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	{
-	    n += noc->core[y]->r->stats.getReceivedFlits();
-#ifdef TESTING
-	    drained_total += noc->core[y]->r->local_drained;
-#endif
-	}
+
+    return (max_matching == 0) ? 1.0 : (double) matched / max_matching;
+}
+
+double GlobalStats::getDeflectionRate()
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    unsigned long deflected = 0;
+    unsigned long hops = 0;
+
+    for (int i = 0; i < graph->size(); i++) {
+	Router * r = noc->node[i]->r;
+
+	deflected += r->getDeflectedFlits();
+	for (int p = 0; p < r->n_ports; p++)
+	    if (graph->hasOutput(i, p))
+		hops += r->getTxFlits(p);
     }
 
+    return (hops == 0) ? 0.0 : (double) deflected / hops;
+}
+
+int GlobalStats::getMaxReassemblyFlits()
+{
+    vector < ProcessingElement * > pes = getProcessingElements();
+    int n = 0;
+
+    for (unsigned int i = 0; i < pes.size(); i++)
+	n = max(n, pes[i]->max_reassembly_flits);
+
     return n;
 }
 
+unsigned long GlobalStats::getMulticastDeliveries()
+{
+    unsigned long n = 0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	n += noc->getCoreStats(i).getMulticastDeliveries();
+
+    return n;
+}
+
+double GlobalStats::getAverageMulticastDelay()
+{
+    unsigned long n = getMulticastDeliveries();
+    double delay = 0.0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	delay += noc->getCoreStats(i).getTotalMulticastDelay();
+
+    return (n == 0) ? -1.0 : delay / n;
+}
+
+double GlobalStats::getMaxMulticastDelay()
+{
+    double maxd = 0.0;
+
+    if (getMulticastDeliveries() == 0)
+	return -1.0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	maxd = max(maxd, noc->getCoreStats(i).getMaxMulticastDelay());
+
+    return maxd;
+}
+
+unsigned long GlobalStats::getClassPackets(const int c)
+{
+    unsigned long n = 0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	n += noc->getCoreStats(i).getClassPackets(c);
+
+    return n;
+}
+
+double GlobalStats::getClassAverageDelay(const int c)
+{
+    unsigned long n = getClassPackets(c);
+    double delay = 0.0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	delay += noc->getCoreStats(i).getClassTotalDelay(c);
+
+    return (n == 0) ? -1.0 : delay / n;
+}
+
+double GlobalStats::getClassMaxDelay(const int c)
+{
+    double maxd = 0.0;
+
+    if (getClassPackets(c) == 0)
+	return -1.0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	maxd = max(maxd, noc->getCoreStats(i).getClassMaxDelay(c));
+
+    return maxd;
+}
+
+double GlobalStats::getClassThroughput(const int c)
+{
+    int total_cycles = GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
+    int cores = TopologyGraph::getInstance()->getCoreCount();
+    unsigned long flits = 0;
+
+    for (int i = 0; i < cores; i++)
+	flits += noc->getCoreStats(i).getClassFlits(c);
+
+    return (double) flits / (double) total_cycles / (double) cores;
+}
+
+unsigned long GlobalStats::getBufferBits()
+{
+    unsigned long bits = 0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	bits += noc->node[i]->r->getBufferBits();
+
+    return bits;
+}
+
+double GlobalStats::getGatedCycleRatio()
+{
+    int n = TopologyGraph::getInstance()->size();
+    double total_cycles = sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+    unsigned long gated = 0;
+
+    for (int i = 0; i < n; i++)
+	gated += noc->node[i]->r->power.getGatedCycles();
+
+    return (total_cycles <= 0) ? 0.0 : gated / (n * total_cycles);
+}
+
+unsigned long GlobalStats::getWakeups()
+{
+    unsigned long wakeups = 0;
+
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	wakeups += noc->node[i]->r->power.getWakeups();
+
+    return wakeups;
+}
+
+double GlobalStats::getAverageRouterFrequency()
+{
+    double total_cycles = sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+
+    return noc->dvfs->getAverageFrequency((long) total_cycles);
+}
+
 double GlobalStats::getThroughput()
 {
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	int number_of_ip = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
-	return (double)getAggregatedThroughput()/(double)(number_of_ip);
-    }
-    else // other delta topologies
-    {
-	int number_of_ip = GlobalParams::n_delta_tiles;
-	return (double)getAggregatedThroughput()/(double)(number_of_ip);
-    }
+    int number_of_ip = TopologyGraph::getInstance()->getCoreCount();
+    return (double)getAggregatedThroughput()/(double)(number_of_ip);
 }
 
 // Only accounting IP that received at least one flit
@@ -277,30 +558,15 @@ double GlobalStats::getActiveThroughput()
     unsigned int n = 0;
     unsigned int trf = 0;
     unsigned int rf ;
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++) 
-	    {
-		rf = noc->t[x][y]->r->stats.getReceivedFlits();
-
-		if (rf != 0)
-		    n++;
 
-		trf += rf;
-	    }
-    }
-    else // other delta topologies
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
     {
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	{
-	    rf = noc->core[y]->r->stats.getReceivedFlits();
+	rf = noc->getCoreStats(i).getReceivedFlits();
 
-	    if (rf != 0)
-		n++;
+	if (rf != 0)
+	    n++;
 
-	    trf += rf;
-	}
+	trf += rf;
     }
 
     return (double) trf / (double) (total_cycles * n);
@@ -311,15 +577,22 @@ vector < vector < unsigned long > > GlobalStats::getRoutedFlitsMtx()
 {
 
     vector < vector < unsigned long > > mtx;
-    assert (GlobalParams::topology == TOPOLOGY_MESH); 
+    assert (isMeshTopology()); 
 
-    mtx.resize(GlobalParams::mesh_dim_y);
-    for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
+    // Layers of 3D meshes are stacked along y
+    mtx.resize(GlobalParams::mesh_dim_y * GlobalParams::mesh_dim_z);
+    for (unsigned int y = 0; y < mtx.size(); y++)
 	mtx[y].resize(GlobalParams::mesh_dim_x);
 
-    for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
+    for (unsigned int y = 0; y < mtx.size(); y++)
 	for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    mtx[y][x] = noc->t[x][y]->r->getRoutedFlits();
+	{
+	    Coord c;
+	    c.x = x;
+	    c.y = y % GlobalParams::mesh_dim_y;
+	    c.z = y / GlobalParams::mesh_dim_y;
+	    mtx[y][x] = noc->node[coord2Id(c)]->r->getRoutedFlits();
+	}
 
 
     return mtx;
@@ -349,29 +622,8 @@ double GlobalStats::getDynamicPower()
     double power = 0.0;
 
     // Electric noc
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		power += noc->t[x][y]->r->power.getDynamicPower();
-    }
-    else // other delta topologies
-    {
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
-	// Dimensions of the delta switch block network
-	int dimX = stg;
-	int dimY = sw;
-
-	// power for delta topologies cores
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	    power += noc->core[y]->r->power.getDynamicPower();
-
-	// power for delta topologies switches 
-	for (int y = 0; y < dimY; y++)
-	    for (int x = 0; x < dimX; x++)
-		power += noc->t[x][y]->r->power.getDynamicPower();
-    }
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	power += noc->node[i]->r->power.getDynamicPower();
 
     // Wireless noc
     for (map<int, HubConfig>::iterator it = GlobalParams::hub_configuration.begin();
@@ -392,28 +644,8 @@ double GlobalStats::getStaticPower()
 {
     double power = 0.0;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-    	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-		for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    power += noc->t[x][y]->r->power.getStaticPower();
-    }
-    else // other delta topologies
-    {
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
-	// Dimensions of the delta switch block network
-	int dimX = stg;
-	int dimY = sw;
-	// power for delta topologies switches 
-	for (int y = 0; y < dimY; y++)
-	    for (int x = 0; x < dimX; x++)
-		power += noc->t[x][y]->r->power.getDynamicPower();
-
-	// delta cores
-    	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-	    power += noc->core[y]->r->power.getStaticPower();
-    }
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	power += noc->node[i]->r->power.getStaticPower();
 
     // Wireless noc
     for (map<int, HubConfig>::iterator it = GlobalParams::hub_configuration.begin();
@@ -434,12 +666,18 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
 {
     if (detailed) 
     {
-	assert (GlobalParams::topology == TOPOLOGY_MESH); 
+	assert (isMeshTopology()); 
 	out << endl << "detailed = [" << endl;
 
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		noc->t[x][y]->r->stats.showStats(y * GlobalParams:: mesh_dim_x + x, out, true);
+	for (int y = 0; y < coreDimY(); y++)
+	    for (int x = 0; x < coreDimX(); x++)
+	    {
+		Coord coord;
+		coord.x = x;
+		coord.y = y;
+		int id = coreCoord2Id(coord);
+		noc->getCoreStats(id).showStats(id, out, true);
+	    }
 	out << "];" << endl;
 
 	// show MaxDelay matrix
@@ -474,20 +712,9 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
 
 #ifdef DEBUG
 
-    if (GlobalParams::topology == TOPOLOGY_MESH)
-    {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-		out << "PE["<<x << "," << y<< "]" << noc->t[x][y]->pe->getQueueSize()<< ",";
-    }
-    else // other delta topologies
-    {
-	out << "Queue sizes: " ;
-	for (int i=0;i<GlobalParams::n_delta_tiles;i++)
-		out << "PE"<<i << ": " << noc->core[i]->pe->getQueueSize()<< ",";
-	out << endl;
-    }
-	
+    out << "Queue sizes: " ;
+    for (int i = 0; i < TopologyGraph::getInstance()->getCoreCount(); i++)
+	out << "PE"<<i << ": " << noc->getCorePE(i)->getQueueSize()<< ",";
     out << endl;
 #endif
 
@@ -498,8 +725,49 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
     out << "% Average wireless utilization: " << getWirelessPackets()/(double)getReceivedPackets() << endl;
     out << "% Global average delay (cycles): " << getAverageDelay() << endl;
     out << "% Max delay (cycles): " << getMaxDelay() << endl;
+    out << "% Average network delay (cycles): " << getAverageNetworkDelay() << endl;
+    out << "% Average hop count: " << getAverageHops() << endl;
+    out << "% Average source queue delay (cycles): " << getAverageSourceQueueDelay() << endl;
+    out << "% Max source queue delay (cycles): " << getMaxSourceQueueDelay() << endl;
     out << "% Network throughput (flits/cycle): " << getAggregatedThroughput() << endl;
     out << "% Average IP throughput (flits/cycle/IP): " << getThroughput() << endl;
+    out << "% Offered load (flits/cycle/IP): " << getOfferedLoad() << endl;
+    out << "% Accepted load (flits/cycle/IP): " << getAcceptedLoad() << endl;
+    out << "% Packets dropped at source: " << getDroppedPackets() << endl;
+    out << "% Switch allocation matching efficiency: " << getMatchingEfficiency() << endl;
+    out << "% Router buffer storage (bits): " << getBufferBits() << endl;
+    if (GlobalParams::request_reply) {
+	out << "% Completed transactions: " << getCompletedTransactions() << endl;
+	out << "% Average transaction round trip delay (cycles): " << getAverageTransactionDelay() << endl;
+	out << "% Max transaction round trip delay (cycles): " << getMaxTransactionDelay() << endl;
+	showMemoryControllerStats(out);
+    }
+    if (GlobalParams::traffic_distribution == TRAFFIC_TRACE)
+	out << "% Trace packets left to replay: " << getTracePacketsLeft() << endl;
+    if (GlobalParams::power_gating != POWER_GATING_NONE) {
+	out << "% Router gated cycles ratio: " << getGatedCycleRatio() << endl;
+	out << "% Router wake-ups: " << getWakeups() << endl;
+    }
+    if (GlobalParams::clock_domains != CLOCK_DOMAINS_NONE) {
+	out << "% Average router frequency (relative): " << getAverageRouterFrequency() << endl;
+	out << "% DVFS transitions: " << noc->dvfs->getTransitions() << endl;
+    }
+    if (GlobalParams::router_architecture == ROUTER_DEFLECTION) {
+	out << "% Deflection rate: " << getDeflectionRate() << endl;
+	out << "% Max reassembly buffer (flits): " << getMaxReassemblyFlits() << endl;
+    }
+    if (GlobalParams::multicast_rate > 0) {
+	out << "% Multicast deliveries: " << getMulticastDeliveries() << endl;
+	out << "% Average multicast delivery delay (cycles): " << getAverageMulticastDelay() << endl;
+	out << "% Max multicast delivery delay (cycles): " << getMaxMulticastDelay() << endl;
+    }
+    if (trafficClasses() > 1)
+	for (int c = 0; c < trafficClasses(); c++) {
+	    out << "% Class " << c << " received packets: " << getClassPackets(c) << endl;
+	    out << "% Class " << c << " average delay (cycles): " << getClassAverageDelay(c) << endl;
+	    out << "% Class " << c << " max delay (cycles): " << getClassMaxDelay(c) << endl;
+	    out << "% Class " << c << " throughput (flits/cycle/IP): " << getClassThroughput(c) << endl;
+	}
     out << "% Total energy (J): " << getTotalPower() << endl;
     out << "% \tDynamic energy (J): " << getDynamicPower() << endl;
     out << "% \tStatic energy (J): " << getStaticPower() << endl;
@@ -507,6 +775,9 @@ void GlobalStats::showStats(std::ostream & out, bool detailed)
     if (GlobalParams::show_buffer_stats)
       showBufferStats(out);
 
+    if (TopologyGraph::getInstance()->hasBoundaryLinks())
+      showBoundaryLinkStats(out);
+
 }
 
 void GlobalStats::updatePowerBreakDown(map<string,double> &dst,PowerBreakdown* src)
@@ -612,23 +883,12 @@ void GlobalStats::showPowerBreakDown(std::ostream & out)
     map<string,double> power_dynamic;
     map<string,double> power_static;
 
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-	    for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-	    {
-		updatePowerBreakDown(power_dynamic, noc->t[x][y]->r->power.getDynamicPowerBreakDown());
-		updatePowerBreakDown(power_static, noc->t[x][y]->r->power.getStaticPowerBreakDown());
-	    }
-    }
-    else // other delta topologies
-    {
-	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
+    for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+	if (!TopologyGraph::getInstance()->getNode(i).cores.empty())
 	{
-	    updatePowerBreakDown(power_dynamic, noc->core[y]->r->power.getDynamicPowerBreakDown());
-	    updatePowerBreakDown(power_static, noc->core[y]->r->power.getStaticPowerBreakDown());
+	    updatePowerBreakDown(power_dynamic, noc->node[i]->r->power.getDynamicPowerBreakDown());
+	    updatePowerBreakDown(power_static, noc->node[i]->r->power.getStaticPowerBreakDown());
 	}
-    }
 
     for (map<int, HubConfig>::iterator it = GlobalParams::hub_configuration.begin();
 	    it != GlobalParams::hub_configuration.end();
@@ -658,42 +918,48 @@ void GlobalStats::showBufferStats(std::ostream & out)
   out << "Router id\tBuffer N\t\tBuffer E\t\tBuffer S\t\tBuffer W\t\tBuffer L" << endl;
   out << "         \tMean\tMax\tMean\tMax\tMean\tMax\tMean\tMax\tMean\tMax" << endl;
   
-  if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-    	for (int y = 0; y < GlobalParams::mesh_dim_y; y++)
-    	for (int x = 0; x < GlobalParams::mesh_dim_x; x++)
-      	{
-			out << noc->t[x][y]->r->local_id;
-			noc->t[x][y]->r->ShowBuffersStats(out);
-			out << endl;
-     	}
-    }
-    else // other delta topologies
+  for (int i = 0; i < TopologyGraph::getInstance()->size(); i++)
+    if (!TopologyGraph::getInstance()->getNode(i).cores.empty())
     {
-    	for (int y = 0; y < GlobalParams::n_delta_tiles; y++)
-    	{
-			out << noc->core[y]->r->local_id;
-			noc->core[y]->r->ShowBuffersStats(out);
-			out << endl;
-     	}
+      out << noc->node[i]->r->local_id;
+      noc->node[i]->r->ShowBuffersStats(out);
+      out << endl;
     }
 
 }
 
+void GlobalStats::showBoundaryLinkStats(std::ostream & out)
+{
+    const vector < TopologyLink > & links = TopologyGraph::getInstance()->getLinks();
+    double total_cycles = sc_time_stamp().to_double() / GlobalParams::clock_period_ps - GlobalParams::reset_time;
+
+    out << "boundary_links = [" << endl;
+    out << "%	Load is the fraction of the wire bandwidth used (flit_size bits per flit)" << endl;
+    out << "%	Src	Port	Dst	Port	Flits	Flits/cycle	Load" << endl;
+
+    for (unsigned int l = 0; l < links.size(); l++)
+	if (links[l].boundary)
+	{
+	    unsigned long flits = noc->node[links[l].src_id]->r->getTxFlits(links[l].src_port);
+	    double rate = flits / total_cycles;
+
+	    out << "	" << links[l].src_id << "	" << links[l].src_port
+		<< "	" << links[l].dst_id << "	" << links[l].dst_port
+		<< "	" << flits << "	" << rate
+		<< "	" << rate * GlobalParams::flit_size / links[l].width << endl;
+	}
+
+    out << "];" << endl;
+}
+
 double GlobalStats::getReceivedIdealFlitRatio()
 {
     int total_cycles;
     total_cycles= GlobalParams::simulation_time - GlobalParams::stats_warm_up_time;
     double ratio;
-    if (GlobalParams::topology == TOPOLOGY_MESH) 
-    {
-	ratio = getReceivedFlits() /(GlobalParams::packet_injection_rate * (GlobalParams::min_packet_size +
-		    GlobalParams::max_packet_size)/2 * total_cycles * GlobalParams::mesh_dim_y * GlobalParams::mesh_dim_x);
-    }
-    else // other delta topologies
-    {
-	ratio = getReceivedFlits() /(GlobalParams::packet_injection_rate * (GlobalParams::min_packet_size +
-		    GlobalParams::max_packet_size)/2 * total_cycles * GlobalParams::n_delta_tiles);
-    }
+
+    ratio = getReceivedFlits() /(GlobalParams::packet_injection_rate * (GlobalParams::min_packet_size +
+		GlobalParams::max_packet_size)/2 * total_cycles * TopologyGraph::getInstance()->getCoreCount());
+
     return ratio;
 }
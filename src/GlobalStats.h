@@ -30,6 +30,32 @@ class GlobalStats {
     // Returns the aggragated average delay (cycles) for communication src_id->dst_id
     double getAverageDelay(const int src_id, const int dst_id);
 
+    // Returns the aggregated average delay (cycles) spent in the
+    // network, i.e. excluding the time spent in the source queues
+    double getAverageNetworkDelay();
+
+    // Returns the average number of router-to-router links crossed by
+    // the received packets
+    double getAverageHops();
+
+    // Returns the average time (cycles) spent by packets in the
+    // source queues before the injection of their head flit
+    double getAverageSourceQueueDelay();
+
+    // Returns the max time (cycles) spent by a packet in a source queue
+    double getMaxSourceQueueDelay();
+
+    // Returns the transactions of request/reply traffic completed by
+    // the reception of their reply, and their average and max round
+    // trip delay (cycles) from the generation of the request
+    unsigned long getCompletedTransactions();
+    double getAverageTransactionDelay();
+    double getMaxTransactionDelay();
+
+    // Shows the requests served by each memory controller, their delay
+    // and the utilization of the banks and of the data bus
+    void showMemoryControllerStats(std::ostream & out);
+
     // Returns the max delay
     double getMaxDelay();
 
@@ -57,6 +83,19 @@ class GlobalStats {
     // communication src_id->dst_id
     double getAverageThroughput(const int src_id, const int dst_id);
 
+    // Returns the load generated by the traffic sources (flits/cycle/IP)
+    double getOfferedLoad();
+
+    // Returns the load accepted by the network, i.e. the flits
+    // injected by the PEs (flits/cycle/IP)
+    double getAcceptedLoad();
+
+    // Returns the number of packets dropped by full source queues
+    unsigned long getDroppedPackets();
+
+    // Returns the number of trace packets not generated yet
+    unsigned long getTracePacketsLeft();
+
     // Returns the total number of received packets
     unsigned int getReceivedPackets();
 
@@ -67,6 +106,41 @@ class GlobalStats {
     unsigned int getWirelessPackets();
 
 
+    // Returns the switch allocation grants over the ones of maximum
+    // matchings of the same requests
+    double getMatchingEfficiency();
+
+    // Returns the fraction of the flits sent on network links that
+    // deflection routers moved away from their destination
+    double getDeflectionRate();
+
+    // Returns the most flits held by a PE to reassemble packets
+    int getMaxReassemblyFlits();
+
+    // Returns the deliveries of multicast packets, one for each
+    // destination, and their average and max delay (cycles)
+    unsigned long getMulticastDeliveries();
+    double getAverageMulticastDelay();
+    double getMaxMulticastDelay();
+
+    // Received packets, average and max delay (cycles) and throughput
+    // (flits/cycle/IP) of traffic class c
+    unsigned long getClassPackets(const int c);
+    double getClassAverageDelay(const int c);
+    double getClassMaxDelay(const int c);
+    double getClassThroughput(const int c);
+
+    // Returns the bits of all the router input buffers
+    unsigned long getBufferBits();
+
+    // Returns the fraction of the router cycles spent power gated, and
+    // the number of wake-ups
+    double getGatedCycleRatio();
+    unsigned long getWakeups();
+
+    // Returns the router clock cycles over the nominal ones, on average
+    double getAverageRouterFrequency();
+
     // Returns the number of routed flits for each router
      vector < vector < unsigned long > > getRoutedFlitsMtx();
 
@@ -83,6 +157,9 @@ class GlobalStats {
 
     void showBufferStats(std::ostream & out);
 
+    // Shows the flits crossing each boundary (interposer) link
+    void showBoundaryLinkStats(std::ostream & out);
+
 
     void showPowerBreakDown(std::ostream & out);
 
@@ -98,6 +175,7 @@ class GlobalStats {
 
   private:
     const NoC *noc;
+    vector < ProcessingElement * > getProcessingElements();
     void updatePowerBreakDown(map<string,double> &dst,PowerBreakdown* src);
 };
 
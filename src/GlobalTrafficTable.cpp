@@ -9,6 +9,7 @@
  */
 
 #include "GlobalTrafficTable.h"
+#include "Utils.h"
 
 GlobalTrafficTable::GlobalTrafficTable()
 {
@@ -34,10 +35,11 @@ bool GlobalTrafficTable::load(const char *fname)
 	int src, dst;	// Mandatory
 	double pir, por;
 	int t_on, t_off, t_period;
+	int traffic_class;
 
 	int params =
-	  sscanf(line, "%d %d %lf %lf %d %d %d", &src, &dst, &pir,
-		 &por, &t_on, &t_off, &t_period);
+	  sscanf(line, "%d %d %lf %lf %d %d %d %d", &src, &dst, &pir,
+		 &por, &t_on, &t_off, &t_period, &traffic_class);
 	if (params >= 2) {
 	  // Create a communication from the parameters read on the line
 	  Communication communication;
@@ -83,6 +85,17 @@ bool GlobalTrafficTable::load(const char *fname)
 	      GlobalParams::reset_time +
 	      GlobalParams::simulation_time;
 
+	  // Custom traffic class
+	  if (params >= 8) {
+	    if (traffic_class < 0 || traffic_class >= trafficClasses()) {
+	      cerr << "Error: traffic class " << traffic_class << " of communication "
+		   << src << " -> " << dst << " is not defined by traffic_class_vcs" << endl;
+	      exit(1);
+	    }
+	    communication.traffic_class = traffic_class;
+	  } else
+	    communication.traffic_class = 0;
+
 	  // Add this communication to the vector of communications
 	  traffic_table.push_back(communication);
 	}
@@ -96,11 +109,13 @@ bool GlobalTrafficTable::load(const char *fname)
 double GlobalTrafficTable::getCumulativePirPor(const int src_id,
 						    const int ccycle,
 						    const bool pir_not_por,
-						    vector < pair < int, double > > &dst_prob)
+						    vector < pair < int, double > > &dst_prob,
+						    vector < int > &dst_class)
 {
   double cpirnpor = 0.0;
 
   dst_prob.clear();
+  dst_class.clear();
 
   for (unsigned int i = 0; i < traffic_table.size(); i++) {
     Communication comm = traffic_table[i];
@@ -110,6 +125,7 @@ double GlobalTrafficTable::getCumulativePirPor(const int src_id,
 	cpirnpor += pir_not_por ? comm.pir : comm.por;
 	pair < int, double >dp(comm.dst, cpirnpor);
 	dst_prob.push_back(dp);
+	dst_class.push_back(comm.traffic_class);
       }
     }
   }
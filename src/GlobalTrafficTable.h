@@ -27,6 +27,7 @@ struct Communication {
   int t_on;			// Time (in cycles) at which activity begins
   int t_off;			// Time (in cycles) at which activity ends
   int t_period;		        // Period after which activity starts again
+  int traffic_class;		// Traffic class of the packets
 };
 
 class GlobalTrafficTable {
@@ -40,11 +41,13 @@ class GlobalTrafficTable {
 
     // Returns the cumulative pir por along with a vector of pairs. The
     // first component of the pair is the destination. The second
-    // component is the cumulative shotting probability.
+    // component is the cumulative shotting probability. dst_class
+    // holds the traffic class of each pair
     double getCumulativePirPor(const int src_id,
 			       const int ccycle,
 			       const bool pir_not_por,
-			       vector < pair < int, double > > &dst_prob);
+			       vector < pair < int, double > > &dst_prob,
+			       vector < int > &dst_class);
 
     // Returns the number of occurrences of soruce src_id in the traffic
     // table
@@ -343,6 +343,7 @@ void Hub::antennaToTileProcess()
 				TReservation r;
 				r.input = channel;
 				r.vc = received_flit.vc_id;
+				r.out_vc = r.vc;
 
 				LOG << " Checking reservation availability of output port " << dst_port << " by channel " << channel << " for flit " << received_flit << endl;
 
@@ -404,6 +405,7 @@ void Hub::antennaToTileProcess()
 						TReservation r;
 						r.input = channel;
 						r.vc = vc;
+						r.out_vc = vc;
 						antenna2tile_reservation_table.release(r,port);
 					}
 				}
@@ -503,6 +505,7 @@ void Hub::tileToAntennaProcess()
 					TReservation r;
 					r.input = i;
 					r.vc = vc;
+					r.out_vc = vc;
 
 					assert(r_from_tile[i][vc]==DIRECTION_WIRELESS);
 					int channel;
@@ -580,6 +583,7 @@ void Hub::tileToAntennaProcess()
 							TReservation r;
 							r.input = i;
 							r.vc = vc;
+							r.out_vc = vc;
 							tile2antenna_reservation_table.release(r,channel);
 						}
 
@@ -635,8 +639,10 @@ void Hub::tileToAntennaProcess()
 		ack_rx[i]->write(current_level_rx[i]);
 		// updates the mask of VCs to prevent incoming data on full buffers
 		TBufferFullStatus bfs;
-		for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++)
+		for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++) {
 			bfs.mask[vc] = buffer_from_tile[i][vc].IsFull();
+			bfs.free_slots[vc] = buffer_from_tile[i][vc].getCurrentFreeSlots();
+		}
 		buffer_full_status_rx[i].write(bfs);
 	}
 
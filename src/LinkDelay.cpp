@@ -0,0 +1,51 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the pipeline of a multi-cycle link
+ */
+
+#include "LinkDelay.h"
+
+void LinkDelay::process()
+{
+    // Signals already take one cycle to propagate and this process adds
+    // another one, the remaining latency is kept in the delay lines
+    int forward_depth = forward_latency - 2;
+    int backward_depth = backward_latency - 2;
+
+    if (reset.read()) {
+	flit_line.reset(forward_depth, flit_in.read());
+	req_line.reset(forward_depth, req_in.read());
+	wake_line.reset(forward_depth, wake_in.read());
+	flit_out.write(flit_in.read());
+	req_out.write(req_in.read());
+	wake_out.write(wake_in.read());
+
+	if (backward_latency > 1) {
+	    ack_line.reset(backward_depth, ack_in.read());
+	    buffer_full_status_line.reset(backward_depth, buffer_full_status_in.read());
+	    free_slots_line.reset(backward_depth, free_slots_in.read());
+	    nop_data_line.reset(backward_depth, nop_data_in.read());
+
+	    ack_out.write(ack_in.read());
+	    buffer_full_status_out.write(buffer_full_status_in.read());
+	    free_slots_out.write(free_slots_in.read());
+	    nop_data_out.write(nop_data_in.read());
+	}
+    } else {
+	flit_out.write(flit_line.shift(flit_in.read()));
+	req_out.write(req_line.shift(req_in.read()));
+	wake_out.write(wake_line.shift(wake_in.read()));
+
+	if (backward_latency > 1) {
+	    ack_out.write(ack_line.shift(ack_in.read()));
+	    buffer_full_status_out.write(buffer_full_status_line.shift(buffer_full_status_in.read()));
+	    free_slots_out.write(free_slots_line.shift(free_slots_in.read()));
+	    nop_data_out.write(nop_data_line.shift(nop_data_in.read()));
+	}
+    }
+}
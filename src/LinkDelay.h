@@ -0,0 +1,108 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the pipeline of a multi-cycle link
+ */
+
+#ifndef __NOXIMLINKDELAY_H__
+#define __NOXIMLINKDELAY_H__
+
+#include <deque>
+#include <systemc.h>
+#include "DataStructs.h"
+
+using namespace std;
+
+// Shift register holding the values in flight on a wire
+template < typename T > class DelayLine {
+
+  public:
+
+    void reset(const int depth, const T & value) {
+	line.assign(depth, value);
+    }
+
+    // Inserts the value sampled in this cycle and returns the oldest one
+    T shift(const T & value) {
+	line.push_back(value);
+	T out = line.front();
+	line.pop_front();
+	return out;
+    }
+
+  private:
+
+    deque < T > line;
+};
+
+// LinkDelay -- placed between the two ends of a link lasting more than
+// one cycle. The forward signals (flit, req, wake) and the backward ones
+// (ack, buffer status, free slots, NoP data) are delayed separately: a
+// link of latency L delivers a flit L cycles after it has been sent,
+// plus the cycles needed to serialize it on a narrow link, and the
+// alternating bit protocol sees the sum of the two delays as round trip.
+// A backward latency of one cycle leaves the backward ports idle, the
+// receiver then drives the sender directly
+SC_MODULE(LinkDelay)
+{
+    SC_HAS_PROCESS(LinkDelay);
+
+    // I/O Ports
+    sc_in_clk clock;		// The input clock for the link
+    sc_in < bool > reset;	// The reset signal for the link
+
+    // Upstream side, i.e. the output port of the sender
+    sc_in < Flit > flit_in;
+    sc_in < bool > req_in;
+    sc_in < bool > wake_in;
+    sc_out < bool > ack_out;
+    sc_out < TBufferFullStatus > buffer_full_status_out;
+    sc_out < int > free_slots_out;
+    sc_out < NoP_data > nop_data_out;
+
+    // Downstream side, i.e. the input port of the receiver
+    sc_out < Flit > flit_out;
+    sc_out < bool > req_out;
+    sc_out < bool > wake_out;
+    sc_in < bool > ack_in;
+    sc_in < TBufferFullStatus > buffer_full_status_in;
+    sc_in < int > free_slots_in;
+    sc_in < NoP_data > nop_data_in;
+
+    // Constructor
+
+    LinkDelay(sc_module_name nm, const int _forward_latency, const int _backward_latency) : sc_module(nm) {
+	assert(_forward_latency > 1 && _backward_latency >= 1);
+	forward_latency = _forward_latency;
+	backward_latency = _backward_latency;
+
+	SC_METHOD(process);
+	sensitive << reset;
+	sensitive << clock.pos();
+    }
+
+    // False if the backward signals take a single cycle, i.e. they
+    // are not routed through the LinkDelay
+    bool delaysBackward() const { return backward_latency > 1; }
+
+  private:
+
+    int forward_latency;	// Cycles from the sender to the receiver
+    int backward_latency;	// Cycles from the receiver to the sender
+
+    DelayLine < Flit > flit_line;
+    DelayLine < bool > req_line;
+    DelayLine < bool > wake_line;
+    DelayLine < bool > ack_line;
+    DelayLine < TBufferFullStatus > buffer_full_status_line;
+    DelayLine < int > free_slots_line;
+    DelayLine < NoP_data > nop_data_line;
+
+    void process();
+};
+
+#endif
@@ -69,28 +69,15 @@ int sc_main(int arg_num, char *arg_vet[])
 	sc_trace(tf, reset, "reset");
 	sc_trace(tf, clock, "clock");
 
-	for (int i = 0; i < GlobalParams::mesh_dim_x; i++) {
-	    for (int j = 0; j < GlobalParams::mesh_dim_y; j++) {
-		char label[64];
-
-		sprintf(label, "req(%02d)(%02d).east", i, j);
-		sc_trace(tf, n->req[i][j].east, label);
-		sprintf(label, "req(%02d)(%02d).west", i, j);
-		sc_trace(tf, n->req[i][j].west, label);
-		sprintf(label, "req(%02d)(%02d).south", i, j);
-		sc_trace(tf, n->req[i][j].south, label);
-		sprintf(label, "req(%02d)(%02d).north", i, j);
-		sc_trace(tf, n->req[i][j].north, label);
-
-		sprintf(label, "ack(%02d)(%02d).east", i, j);
-		sc_trace(tf, n->ack[i][j].east, label);
-		sprintf(label, "ack(%02d)(%02d).west", i, j);
-		sc_trace(tf, n->ack[i][j].west, label);
-		sprintf(label, "ack(%02d)(%02d).south", i, j);
-		sc_trace(tf, n->ack[i][j].south, label);
-		sprintf(label, "ack(%02d)(%02d).north", i, j);
-		sc_trace(tf, n->ack[i][j].north, label);
-	    }
+	const vector < TopologyLink > & links = TopologyGraph::getInstance()->getLinks();
+
+	for (unsigned int l = 0; l < links.size(); l++) {
+	    char label[64];
+
+	    sprintf(label, "req(%02d.%d)(%02d.%d)", links[l].src_id, links[l].src_port, links[l].dst_id, links[l].dst_port);
+	    sc_trace(tf, n->link[l].req, label);
+	    sprintf(label, "ack(%02d.%d)(%02d.%d)", links[l].src_id, links[l].src_port, links[l].dst_id, links[l].dst_port);
+	    sc_trace(tf, n->link[l].ack, label);
 	}
     }
     // Reset the chip and run the simulation
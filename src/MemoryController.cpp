@@ -0,0 +1,95 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the memory controller endpoint
+ */
+
+#include "MemoryController.h"
+
+MemoryController::MemoryController(sc_module_name nm) : ProcessingElement(nm)
+{
+    bank_queue.resize(GlobalParams::memory_banks);
+    bank_busy.resize(GlobalParams::memory_banks);
+    bank_done.resize(GlobalParams::memory_banks);
+}
+
+void MemoryController::txProcess()
+{
+    if (reset.read()) {
+	for (int b = 0; b < GlobalParams::memory_banks; b++) {
+	    bank_queue[b].clear();
+	    bank_busy[b] = false;
+	}
+	data_queue.clear();
+	bus_free = 0.0;
+	queued_requests = 0;
+	served_requests = 0;
+	total_service_delay = 0.0;
+	bank_busy_cycles = bus_busy_cycles = 0.0;
+	max_queued_requests = 0;
+    }
+    else
+	serve();
+
+    // Injects the replies made ready
+    ProcessingElement::txProcess();
+}
+
+void MemoryController::serveRequest(const Flit & request)
+{
+    MemoryRequest m;
+
+    m.reply = replyTo(request);
+    m.arrival = m.reply.ready;
+    bank_queue[rand() % GlobalParams::memory_banks].push_back(m);
+
+    queued_requests++;
+    if (collectingStats() && queued_requests > max_queued_requests)
+	max_queued_requests = queued_requests;
+}
+
+void MemoryController::serve()
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    bool stats = collectingStats();
+
+    for (int b = 0; b < GlobalParams::memory_banks; b++) {
+	if (bank_busy[b] && now >= bank_done[b]) {
+	    data_queue.push_back(bank_queue[b].front());
+	    bank_queue[b].pop_front();
+	    bank_busy[b] = false;
+	}
+
+	if (!bank_busy[b] && !bank_queue[b].empty()) {
+	    bank_busy[b] = true;
+	    bank_done[b] = now + GlobalParams::memory_latency;
+	}
+
+	if (bank_busy[b] && stats)
+	    bank_busy_cycles++;
+    }
+
+    // The data bus serializes the replies, which are ready once their
+    // last flit is transferred
+    while (!data_queue.empty() && bus_free <= now) {
+	double transfer = GlobalParams::reply_packet_size / GlobalParams::memory_bandwidth;
+	PendingReply reply = data_queue.front().reply;
+
+	bus_free = max(bus_free, now) + transfer;
+	reply.ready = bus_free;
+	pending_replies.push_back(reply);
+
+	if (stats) {
+	    served_requests++;
+	    total_service_delay += reply.ready - data_queue.front().arrival;
+	    bus_busy_cycles += transfer;
+	}
+
+	data_queue.pop_front();
+	queued_requests--;
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the memory controller endpoint
+ */
+
+#ifndef __NOXIMMEMORYCONTROLLER_H__
+#define __NOXIMMEMORYCONTROLLER_H__
+
+#include <deque>
+#include <vector>
+#include "ProcessingElement.h"
+
+using namespace std;
+
+// A request received by a memory controller
+struct MemoryRequest {
+    PendingReply reply;
+    double arrival;		// Cycle the request was received
+};
+
+// MemoryController -- endpoint taking the place of the PE of a core. It
+// generates no traffic and serves the requests it receives: each one
+// waits in the queue of a random bank, i.e. of the interleaved address,
+// the bank accesses the requests one at a time in memory_latency cycles
+// each, and the replies leave in order of access through a data bus of
+// memory_bandwidth flits per cycle
+class MemoryController : public ProcessingElement {
+
+  public:
+
+    MemoryController(sc_module_name nm);
+
+    void txProcess();
+    bool canShot(Packet &) { return false; }
+    void serveRequest(const Flit & request);
+
+    // Statistics, collected after the warm-up
+    unsigned long served_requests;
+    double total_service_delay;	// Reception of the requests to generation of their replies (cycles)
+    double bank_busy_cycles;	// Summed over the banks
+    double bus_busy_cycles;
+    unsigned int max_queued_requests;	// Requests waiting in the banks and for the bus
+
+  private:
+
+    vector < deque < MemoryRequest > > bank_queue;	// Front one accessed by the bank, if busy
+    vector < bool > bank_busy;
+    vector < double > bank_done;	// Cycle the access in progress ends
+    deque < MemoryRequest > data_queue;	// Accessed requests waiting for the data bus
+    double bus_free;		// Cycle the data bus ends the transfer in progress
+    unsigned int queued_requests;
+
+    void serve();
+};
+
+#endif
@@ -18,64 +18,76 @@
 #include "Hub.h"
 #include "Channel.h"
 #include "TokenRing.h"
+#include "TopologyGraph.h"
+#include "LinkDelay.h"
+#include "DeadlockDetector.h"
+#include "DVFSController.h"
 
 using namespace std;
 
-template <typename T>
-struct sc_signal_NSWE
+// Signals of a unidirectional link between two routers
+struct LinkSignals
 {
-    sc_signal<T> east;
-    sc_signal<T> west;
-    sc_signal<T> south;
-    sc_signal<T> north;
+    sc_signal<Flit> flit;
+    sc_signal<bool> req;
+    sc_signal<bool> ack;
+    sc_signal<TBufferFullStatus> buffer_full_status;
+
+    // Side-band from the upstream router, asking to wake up
+    sc_signal<bool> wake;
+
+    // Side-band from the downstream router
+    sc_signal<int> free_slots;
+    sc_signal<NoP_data> nop_data;
 };
 
-template <typename T>
-struct sc_signal_NSWEH
+// Signals connecting a tile to its hub
+struct HubSignals
 {
-    sc_signal<T> east;
-    sc_signal<T> west;
-    sc_signal<T> south;
-    sc_signal<T> north;
-    sc_signal<T> to_hub;
-    sc_signal<T> from_hub;
+    sc_signal<Flit> flit_to_hub;
+    sc_signal<Flit> flit_from_hub;
+
+    sc_signal<bool> req_to_hub;
+    sc_signal<bool> req_from_hub;
+
+    sc_signal<bool> ack_to_hub;
+    sc_signal<bool> ack_from_hub;
+
+    sc_signal<TBufferFullStatus> buffer_full_status_to_hub;
+    sc_signal<TBufferFullStatus> buffer_full_status_from_hub;
 };
 
 
 SC_MODULE(NoC)
 {
-    public: bool SwitchOnly; //true if the tile are switch only 
     // I/O Ports
     sc_in_clk clock;		// The input clock for the NoC
     sc_in < bool > reset;	// The reset signal for the NoC
 
-    // Signals mesh and switch bloc in delta topologies
-    sc_signal_NSWEH<bool> **req;
-    sc_signal_NSWEH<bool> **ack;
-    sc_signal_NSWEH<TBufferFullStatus> **buffer_full_status;
-    sc_signal_NSWEH<Flit> **flit;
-    sc_signal_NSWE<int> **free_slots;
-
-    // NoP
-    sc_signal_NSWE<NoP_data> **nop_data;
+    // Signals of the links of the topology graph, driven by the sender
+    LinkSignals *link;
 
-    //signals for connecting Core2Hub (just to test wireless in Butterfly)
-    sc_signal<Flit> *flit_from_hub;
-    sc_signal<Flit> *flit_to_hub;
+    // Signals seen by the receiver of each link. They differ from the
+    // ones in link only for links lasting more than one cycle, whose
+    // ends are connected through a LinkDelay. If only the forward
+    // direction is delayed the receiver drives link backward signals
+    LinkSignals **link_rx;
+    map<int, LinkDelay*> link_delay;
 
-    sc_signal<bool> *req_from_hub;
-    sc_signal<bool> *req_to_hub;
+    // Signals of the ports not connected to any link
+    LinkSignals *ground;	// read by unconnected inputs
+    LinkSignals *sink;		// written by unconnected outputs
 
-    sc_signal<bool> *ack_from_hub;
-    sc_signal<bool> *ack_to_hub;
+    // Signals connecting each tile to its hub
+    HubSignals *hub_signals;
 
-    sc_signal<TBufferFullStatus> *buffer_full_status_from_hub;
-    sc_signal<TBufferFullStatus> *buffer_full_status_to_hub;
+    // Tiles indexed by id
+    Tile ** node;
 
-
-
-    // Matrix of tiles
+    // Matrix of tiles (mesh tiles, delta switches)
     Tile ***t;
+
+    // Tile each core is attached to, indexed by core id
     Tile ** core;
 
     map<int, Hub*> hub;
@@ -83,9 +95,13 @@ SC_MODULE(NoC)
 
     TokenRing* token_ring;
 
+    // Clock domains of the routers, NULL with a single clock
+    DVFSController * dvfs;
+
     // Global tables
     GlobalRoutingTable grtable;
     GlobalTrafficTable gttable;
+    TrafficTrace trace;
 
 
     // Constructor
@@ -94,19 +110,8 @@ SC_MODULE(NoC)
     {
 
 
-	if (GlobalParams::topology == TOPOLOGY_MESH)
-	    // Build the Mesh
-	    buildMesh();
-	else if (GlobalParams::topology == TOPOLOGY_BUTTERFLY)
-        buildButterfly(); 
-	else if (GlobalParams::topology == TOPOLOGY_BASELINE)
-	    buildBaseline();
-	else if (GlobalParams::topology == TOPOLOGY_OMEGA)
-	    buildOmega();
-	else {
-	    cerr << "ERROR: Topology " << GlobalParams::topology << " is not yet supported." << endl;
-	    exit(0);
-    }
+	buildTopology();
+
 	GlobalParams::channel_selection = CHSEL_RANDOM;
 	// out of yaml configuration (experimental features)
 	//GlobalParams::channel_selection = CHSEL_FIRST_FREE;
@@ -117,19 +122,46 @@ SC_MODULE(NoC)
 	    sensitive << clock.pos();
 	}
 
+	// Deflection routers never hold flits in the network
+	deadlock_detector = NULL;
+	if (GlobalParams::deadlock_check_period > 0 &&
+	    GlobalParams::router_architecture == ROUTER_BUFFERED)
+	{
+	    deadlock_detector = new DeadlockDetector(this);
+	    SC_METHOD(deadlockMonitor);
+	    sensitive << clock.pos();
+	}
+
+	dvfs = NULL;
+	if (GlobalParams::clock_domains != CLOCK_DOMAINS_NONE)
+	{
+	    dvfs = new DVFSController(this);
+	    for (int id = 0; id < TopologyGraph::getInstance()->size(); id++)
+		node[id]->r->setClockDomain(dvfs);
+	    SC_METHOD(dvfsMonitor);
+	    sensitive << reset;
+	    sensitive << clock.pos();
+	}
+
     }
 
     // Support methods
     Tile *searchNode(const int id) const;
 
+    // PE and statistics of a core
+    ProcessingElement *getCorePE(const int core_id) const;
+    Stats & getCoreStats(const int core_id) const;
+
   private:
 
-    void buildMesh();
-    void buildButterfly();
-    void buildBaseline();
-    void buildOmega();
+    void buildTopology();
     void buildCommon();
+    void bindOutput(Tile * tile, const int port, LinkSignals * out, LinkSignals * in);
+    void bindInput(Tile * tile, const int port, LinkSignals * out, LinkSignals * in);
     void asciiMonitor();
+    void deadlockMonitor();
+    void dvfsMonitor();
+    DeadlockDetector * deadlock_detector;
     int * hub_connected_ports;
 };
 
@@ -60,6 +60,7 @@ Power::Power()
 
     link_r2r_pwr_d = 0.0;
     link_r2r_pwr_s = 0.0;
+    link_r2r_width = 0;
     link_r2h_pwr_s = 0.0;
     link_r2h_pwr_d = 0.0;
 
@@ -71,6 +72,11 @@ Power::Power()
 
     sleep_end_cycle = NOT_VALID;
 
+    gated_cycles = 0;
+    wakeups = 0;
+
+    setVoltage(1.0);
+
     initPowerBreakdown();
 }
 
@@ -78,7 +84,9 @@ void Power::configureRouter(int link_width,
 	int buffer_depth,
 	int buffer_item_size,
 	string routing_function,
-	string selection_function)
+	string selection_function,
+	int n_ports,
+	int crossbar_ports)
 {
 // (s)tatic, (d)ynamic power
 
@@ -111,11 +119,9 @@ void Power::configureRouter(int link_width,
     selection_pwr_d = GlobalParams::power_configuration.routerPowerConfig.selection_strategy_pm[selection_function].second;
 
     // CrossBar
-    // TODO future work: tuning of crossbar radix
-    pair<int,int> xbar_k = pair<int,int>(5,GlobalParams::flit_size);
-    assert(GlobalParams::power_configuration.routerPowerConfig.crossbar_pm.find(xbar_k) != GlobalParams::power_configuration.routerPowerConfig.crossbar_pm.end());
-    crossbar_pwr_s = W2J(GlobalParams::power_configuration.routerPowerConfig.crossbar_pm[xbar_k].first);
-    crossbar_pwr_d = GlobalParams::power_configuration.routerPowerConfig.crossbar_pm[xbar_k].second;
+    pair<double, double> xbar_pm = crossbarPower(crossbar_ports);
+    crossbar_pwr_s = W2J(xbar_pm.first);
+    crossbar_pwr_d = xbar_pm.second;
     
     // NetworkInterface
     ni_pwr_s = W2J(GlobalParams::power_configuration.routerPowerConfig.network_interface[GlobalParams::flit_size].first);
@@ -126,16 +132,109 @@ void Power::configureRouter(int link_width,
     double length_r2h = GlobalParams::r2h_link_length;
     double length_r2r = GlobalParams::r2r_link_length;
     
-    assert(GlobalParams::power_configuration.linkBitLinePowerConfig.find(length_r2r)!=GlobalParams::power_configuration.linkBitLinePowerConfig.end());
     assert(GlobalParams::power_configuration.linkBitLinePowerConfig.find(length_r2h)!=GlobalParams::power_configuration.linkBitLinePowerConfig.end());
 
+    pair<double, double> link_r2r_pm = linkBitLinePower(length_r2r);
 
-    link_r2r_pwr_s= W2J(link_width * GlobalParams::power_configuration.linkBitLinePowerConfig[length_r2r].first);
-    link_r2r_pwr_d= link_width * GlobalParams::power_configuration.linkBitLinePowerConfig[length_r2r].second;
+    link_r2r_width = link_width;
+    link_r2r_pwr_s= W2J(link_width * link_r2r_pm.first);
+    link_r2r_pwr_d= link_width * link_r2r_pm.second;
+    link_r2r_port_pwr_d.assign(n_ports, link_r2r_pwr_d);
     link_r2h_pwr_s= W2J(link_width * GlobalParams::power_configuration.linkBitLinePowerConfig[length_r2h].first);
     link_r2h_pwr_d= link_width * GlobalParams::power_configuration.linkBitLinePowerConfig[length_r2h].second;
 }
 
+void Power::configureBufferPool(int size, int item_size, int pointer_bits)
+{
+    // The smallest characterized buffer able to hold the pool
+    map< pair<int,int>, double > & leakage = GlobalParams::power_configuration.bufferPowerConfig.leakage;
+    map< pair<int,int>, double >::iterator it = leakage.lower_bound(pair<int,int>(size, 0));
+
+    while (it != leakage.end() && it->first.second != item_size)
+	it++;
+
+    if (it == leakage.end()) {
+	cerr << "Error: no buffer of at least " << size << " x " << item_size << " bits in the power configuration" << endl;
+	exit(1);
+    }
+
+    pair<int,int> key = it->first;
+    double scale = (double) (item_size + pointer_bits) / item_size;
+
+    buffer_router_pwr_s = W2J(leakage[key]) * scale;
+    buffer_router_push_pwr_d = GlobalParams::power_configuration.bufferPowerConfig.push[key] * scale;
+    buffer_router_front_pwr_d = GlobalParams::power_configuration.bufferPowerConfig.front[key] * scale;
+    buffer_router_pop_pwr_d = GlobalParams::power_configuration.bufferPowerConfig.pop[key] * scale;
+}
+
+void Power::configureLink(int port, double length, bool vertical)
+{
+    assert(port >= 0 && port < (int) link_r2r_port_pwr_d.size());
+
+    const PowerConfig & pc = GlobalParams::power_configuration;
+
+    if (vertical && pc.hasVerticalLinkBitLine)
+	link_r2r_port_pwr_d[port] = link_r2r_width * pc.verticalLinkBitLinePowerConfig.second;
+    else
+	link_r2r_port_pwr_d[port] = link_r2r_width * linkBitLinePower(length).second;
+}
+
+pair<double, double> Power::linkBitLinePower(double length) const
+{
+    const LinkBitLinePowerConfig & lbl = GlobalParams::power_configuration.linkBitLinePowerConfig;
+
+    assert(!lbl.empty());
+
+    LinkBitLinePowerConfig::const_iterator next = lbl.lower_bound(length);
+
+    if (next != lbl.end() && next->first == length)
+	return next->second;
+
+    // Wires longer (shorter) than the characterized ones scale linearly
+    // with the length of the longest (shortest) one
+    if (next == lbl.end() || next == lbl.begin())
+    {
+	if (next == lbl.end())
+	    next--;
+	double k = length / next->first;
+	return pair<double, double>(k * next->second.first, k * next->second.second);
+    }
+
+    LinkBitLinePowerConfig::const_iterator prev = next;
+    prev--;
+
+    double k = (length - prev->first) / (next->first - prev->first);
+
+    return pair<double, double>(prev->second.first + k * (next->second.first - prev->second.first),
+				prev->second.second + k * (next->second.second - prev->second.second));
+}
+
+pair<double, double> Power::crossbarPower(int radix) const
+{
+    const map<pair<double, double>, pair<double, double> > & xbar = GlobalParams::power_configuration.routerPowerConfig.crossbar_pm;
+
+    map<pair<double, double>, pair<double, double> >::const_iterator it = xbar.find(pair<double, double>(radix, GlobalParams::flit_size));
+
+    if (it != xbar.end())
+	return it->second;
+
+    // Look for the closest radix characterized for the same flit size
+    map<pair<double, double>, pair<double, double> >::const_iterator best = xbar.end();
+
+    for (it = xbar.begin(); it != xbar.end(); it++)
+	if (it->first.second == GlobalParams::flit_size &&
+	    (best == xbar.end() || fabs(it->first.first - radix) < fabs(best->first.first - radix)))
+	    best = it;
+
+    assert(best != xbar.end());
+
+    // A radix-k crossbar has k*k crosspoints, while a flit only drives
+    // one input and one output line, whose length grows with k
+    double k = radix / best->first.first;
+
+    return pair<double, double>(k * k * best->second.first, k * best->second.second);
+}
+
 void Power::configureHub(int link_width,
 	int buffer_to_tile_depth, // buffer to tile
 	int buffer_from_tile_depth, // buffer from tile
@@ -239,17 +338,17 @@ void Power::configureHub(int link_width,
 // Router buffer
 void Power::bufferRouterPush()
 {
-    power_dynamic.breakdown[BUFFER_PUSH_PWR_D].value += buffer_router_push_pwr_d;
+    power_dynamic.breakdown[BUFFER_PUSH_PWR_D].value += dynamic_scale * buffer_router_push_pwr_d;
 }
 
 void Power::bufferRouterPop()
 {
-    power_dynamic.breakdown[BUFFER_POP_PWR_D].value += buffer_router_pop_pwr_d;
+    power_dynamic.breakdown[BUFFER_POP_PWR_D].value += dynamic_scale * buffer_router_pop_pwr_d;
 }
 
 void Power::bufferRouterFront()
 {
-    power_dynamic.breakdown[BUFFER_FRONT_PWR_D].value += buffer_router_front_pwr_d;
+    power_dynamic.breakdown[BUFFER_FRONT_PWR_D].value += dynamic_scale * buffer_router_front_pwr_d;
 }
 
 // Hub to tile
@@ -306,32 +405,33 @@ void Power::antennaBufferFront()
 
 void Power::routing()
 {
-    power_dynamic.breakdown[ROUTING_PWR_D].value += routing_pwr_d;
+    power_dynamic.breakdown[ROUTING_PWR_D].value += dynamic_scale * routing_pwr_d;
 }
 
 void Power::selection()
 {
-    power_dynamic.breakdown[SELECTION_PWR_D].value +=selection_pwr_d ;
+    power_dynamic.breakdown[SELECTION_PWR_D].value += dynamic_scale * selection_pwr_d;
 }
 
 void Power::crossBar()
 {
-    power_dynamic.breakdown[CROSSBAR_PWR_D].value +=crossbar_pwr_d;
+    power_dynamic.breakdown[CROSSBAR_PWR_D].value += dynamic_scale * crossbar_pwr_d;
 }
 
-void Power::r2rLink()
+void Power::r2rLink(int port)
 {
-    power_dynamic.breakdown[LINK_R2R_PWR_D].value +=link_r2r_pwr_d;
+    assert(port >= 0 && port < (int) link_r2r_port_pwr_d.size());
+    power_dynamic.breakdown[LINK_R2R_PWR_D].value += dynamic_scale * link_r2r_port_pwr_d[port];
 }
 
 void Power::r2hLink()
 {
-    power_dynamic.breakdown[LINK_R2H_PWR_D].value +=link_r2h_pwr_d;
+    power_dynamic.breakdown[LINK_R2H_PWR_D].value += dynamic_scale * link_r2h_pwr_d;
 }
 
 void Power::networkInterface()
 {
-    power_dynamic.breakdown[NI_PWR_D].value +=ni_pwr_d;
+    power_dynamic.breakdown[NI_PWR_D].value += dynamic_scale * ni_pwr_d;
 }
 
 
@@ -405,7 +505,7 @@ void Power::biasingTx()
 // - Hub: takes the leakage value of buffer_from_tile/to_tile
 void Power::leakageBufferRouter()
 {
-    power_static.breakdown[BUFFER_ROUTER_PWR_S].value +=buffer_router_pwr_s;
+    power_static.breakdown[BUFFER_ROUTER_PWR_S].value += static_scale * buffer_router_pwr_s;
 }
 
 void Power::leakageBufferToTile()
@@ -431,19 +531,41 @@ void Power::leakageLinkRouter2Router()
 
 void Power::leakageLinkRouter2Hub()
 {
-    power_static.breakdown[LINK_R2H_PWR_S].value +=link_r2h_pwr_s;
+    power_static.breakdown[LINK_R2H_PWR_S].value += static_scale * link_r2h_pwr_s;
 }
 
 void Power::leakageRouter()
 {
     // note: leakage contributions depending on instance number are 
     // accounted in specific separate leakage functions
-    power_static.breakdown[ROUTING_PWR_S].value +=routing_pwr_s;
-    power_static.breakdown[SELECTION_PWR_S].value +=selection_pwr_s;
-    power_static.breakdown[CROSSBAR_PWR_S].value +=crossbar_pwr_s;
-    power_static.breakdown[NI_PWR_S].value +=ni_pwr_s;
+    power_static.breakdown[ROUTING_PWR_S].value += static_scale * routing_pwr_s;
+    power_static.breakdown[SELECTION_PWR_S].value += static_scale * selection_pwr_s;
+    power_static.breakdown[CROSSBAR_PWR_S].value += static_scale * crossbar_pwr_s;
+    power_static.breakdown[NI_PWR_S].value += static_scale * ni_pwr_s;
+}
+
+
+void Power::routerGated()
+{
+    gated_cycles++;
+}
+
+void Power::routerWakeup()
+{
+    power_dynamic.breakdown[ROUTER_WAKEUP_PWR_D].value += dynamic_scale * GlobalParams::power_gating_wakeup_energy;
+    wakeups++;
 }
 
+double Power::routerBreakEven(int buffers) const
+{
+    double leakage = static_scale * (routing_pwr_s + selection_pwr_s + crossbar_pwr_s + ni_pwr_s +
+				     buffers * buffer_router_pwr_s);
+
+    if (leakage <= 0.0)
+	return 0.0;
+
+    return dynamic_scale * GlobalParams::power_gating_wakeup_energy / leakage;
+}
 
 
 void Power::leakageTransceiverRx()
@@ -515,6 +637,7 @@ void Power::initPowerBreakdown()
     initPowerBreakdownEntry(&power_dynamic.breakdown[LINK_R2R_PWR_D],"link_r2r_pwr_d");
     initPowerBreakdownEntry(&power_dynamic.breakdown[LINK_R2H_PWR_D],"link_r2h_pwr_d");
     initPowerBreakdownEntry(&power_dynamic.breakdown[NI_PWR_D],"ni_pwr_d");
+    initPowerBreakdownEntry(&power_dynamic.breakdown[ROUTER_WAKEUP_PWR_D],"router_wakeup_pwr_d");
     initPowerBreakdownEntry(&power_dynamic.breakdown[WIRELESS_TX],"wireless_tx");
     initPowerBreakdownEntry(&power_dynamic.breakdown[WIRELESS_DYNAMIC_RX_PWR],"wireless_dynamic_rx_pwr");
     initPowerBreakdownEntry(&power_dynamic.breakdown[WIRELESS_SNOOPING],"wireless_snooping");
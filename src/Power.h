@@ -32,7 +32,18 @@ class Power {
 	                 int buffer_depth,
 			 int buffer_item_size,
 			 string routing_function,
-			 string selection_function);
+			 string selection_function,
+			 int n_ports,
+			 int crossbar_ports);
+
+    // Replaces the per-VC buffers with a DAMQ pool of size slots,
+    // each one extended with the pointer of the linked lists
+    void configureBufferPool(int size, int item_size, int pointer_bits);
+
+    // Sets the length (mm) of the link leaving the output port. Vertical
+    // links between the layers of a 3D stack use the VerticalLinkBitLine
+    // energy, if characterized
+    void configureLink(int port, double length, bool vertical = false);
 
     void configureHub(int link_width, 
 	              int buffer_to_tile_depth, 
@@ -64,7 +75,7 @@ class Power {
     void selection(); 
     void crossBar(); 
     void r2hLink(); 
-    void r2rLink(); 
+    void r2rLink(int port); 
     void networkInterface();
 
     void leakageBufferRouter();
@@ -79,6 +90,22 @@ class Power {
     void biasingRx();
     void biasingTx();
 
+    // Router power gating: a gated cycle leaks nothing, a wake-up costs
+    // power_gating_wakeup_energy. The break-even time is the cycles the
+    // router, with the given number of input buffers, takes to leak it
+    void routerGated();
+    void routerWakeup();
+    double routerBreakEven(int buffers) const;
+    unsigned long getGatedCycles() const { return gated_cycles; }
+    unsigned long getWakeups() const { return wakeups; }
+
+    // DVFS: supply voltage of the router relative to the nominal one.
+    // Dynamic energy scales with its square, leakage power linearly
+    void setVoltage(double voltage) {
+	dynamic_scale = voltage * voltage;
+	static_scale = voltage;
+    }
+
     double getDynamicPower();
     double getStaticPower();
 
@@ -140,6 +167,8 @@ class Power {
 
     double link_r2r_pwr_d;
     double link_r2r_pwr_s;
+    int link_r2r_width;
+    vector < double > link_r2r_port_pwr_d;	// Per output port, local ones included
     double link_r2h_pwr_s;
     double link_r2h_pwr_d;
 
@@ -149,6 +178,14 @@ class Power {
     map< pair<int, int> , double>  attenuation_map;
     double attenuation2power(double);
 
+    // Bit line (leakage, dynamic) power of a link, interpolated if
+    // the length is not in the power configuration
+    pair<double, double> linkBitLinePower(double length) const;
+
+    // Crossbar (leakage, dynamic) power for the given radix, scaled from
+    // the closest radix in the power configuration if not characterized
+    pair<double, double> crossbarPower(int radix) const;
+
 
     void printBreakDown(string label, const map<string,double> & m,std::ostream & out) const;
 
@@ -164,6 +201,12 @@ class Power {
 
     int sleep_end_cycle;
 
+    unsigned long gated_cycles;
+    unsigned long wakeups;
+
+    double dynamic_scale;
+    double static_scale;
+
 
     
 };
@@ -21,12 +21,37 @@ void ProcessingElement::rxProcess()
     if (reset.read()) {
 	ack_rx.write(0);
 	current_level_rx = 0;
+	for (int vc = 0; vc < MAX_VIRTUAL_CHANNELS; vc++)
+	    credits_freed[vc] = 0;
+	buffer_full_status_rx.write(TBufferFullStatus());
+	reassembly.clear();
+	reassembly_flits = 0;
+	max_reassembly_flits = 0;
     } else {
 	if (req_rx.read() == 1 - current_level_rx) {
 	    Flit flit_tmp = flit_rx.read();
 	    current_level_rx = 1 - current_level_rx;	// Negate the old value for Alternating Bit Protocol (ABP)
+	    credits_freed[flit_tmp.vc_id]++;
+
+	    bool complete;
+	    if (reassembly_stats)
+		complete = reassemble(flit_tmp);
+	    else
+		complete = (flit_tmp.sequence_no == flit_tmp.sequence_length - 1);
+
+	    // Releases the trace packets depending on this one
+	    if (complete && flit_tmp.trace_id != NOT_VALID)
+		traffic_trace->setDelivered(flit_tmp.trace_id);
+
+	    if (complete && flit_tmp.transaction_type != TRANSACTION_NONE)
+		receivedTransaction(flit_tmp);
 	}
 	ack_rx.write(current_level_rx);
+
+	TBufferFullStatus bfs;
+	for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+	    bfs.credits[vc] = credits_freed[vc];
+	buffer_full_status_rx.write(bfs);
     }
 }
 
@@ -34,41 +59,199 @@ void ProcessingElement::txProcess()
 {
     if (reset.read()) {
 	req_tx.write(0);
+	wake_tx.write(false);
 	current_level_tx = 0;
 	transmittedAtPreviousCycle = false;
+	source_stalled = false;
+	for (int vc = 0; vc < MAX_VIRTUAL_CHANNELS; vc++) {
+	    vc_queue_occupancy[vc] = 0;
+	    credits_used[vc] = 0;
+	}
+	offered_packets = offered_flits = 0;
+	dropped_packets = dropped_flits = 0;
+	injected_flits = 0;
+	source_delay_samples = 0;
+	total_source_delay = max_source_delay = 0.0;
+	if (traffic_trace)
+	    trace_cursor = traffic_trace->getCursor(local_id);
+	trace_waiting.clear();
+	pending_replies.clear();
+	outstanding.clear();
+	next_transaction = 0;
+	completed_transactions = 0;
+	total_transaction_delay = max_transaction_delay = 0.0;
     } else {
 	Packet packet;
 
-	if (canShot(packet)) {
-	    packet_queue.push(packet);
+	// Replies are not dropped, they wait for room in the source queue
+	if (replyReady(packet) && !sourceQueueFull(packet)) {
+	    if (collectingStats()) {
+		offered_packets++;
+		offered_flits += packet.size;
+	    }
+	    enqueuePacket(packet);
+	    pending_replies.pop_front();
+	}
+
+	if (source_stalled) {
+	    // The source cannot generate until the pending packet is queued
+	    if (!sourceQueueFull(stalled_packet)) {
+		enqueuePacket(stalled_packet);
+		source_stalled = false;
+	    }
+	    transmittedAtPreviousCycle = false;
+	} else if (canShot(packet)) {
+	    if (collectingStats()) {
+		offered_packets++;
+		offered_flits += packet.size * sourceCopies(packet);
+	    }
+
+	    if (!sourceQueueFull(packet))
+		enqueuePacket(packet);
+	    else if (GlobalParams::source_queue_policy == SOURCE_QUEUE_DROP) {
+		if (collectingStats()) {
+		    dropped_packets++;
+		    dropped_flits += packet.size * sourceCopies(packet);
+		}
+	    } else {
+		stalled_packet = packet;
+		source_stalled = true;
+	    }
 	    transmittedAtPreviousCycle = true;
 	} else
 	    transmittedAtPreviousCycle = false;
 
 
-	if (ack_tx.read() == current_level_tx) {
-	    if (!packet_queue.empty()) {
-		Flit flit = nextFlit();	// Generate a new flit
-		flit_tx->write(flit);	// Send the generated flit
-		current_level_tx = 1 - current_level_tx;	// Negate the old value for Alternating Bit Protocol (ABP)
-		req_tx.write(current_level_tx);
-	    }
+	queue < Packet > * q = txQueue();
+	wake_tx.write(q != NULL);
+	if (q != NULL && canSend(q->front().vc_id)) {
+	    Flit flit = nextFlit();	// Generate a new flit
+	    flit_tx->write(flit);	// Send the generated flit
+	    current_level_tx = 1 - current_level_tx;	// Negate the old value for Alternating Bit Protocol (ABP)
+	    req_tx.write(current_level_tx);
+	    credits_used[flit.vc_id]++;
+	    if (collectingStats())
+		injected_flits++;
 	}
     }
 }
 
+bool ProcessingElement::reassemble(const Flit & flit)
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    // Trace packets, and a request and a reply, of a source may share
+    // the timestamp
+    tuple < int, double, long, int > key(flit.src_id, flit.timestamp, flit.trace_id, flit.transaction_type);
+    int received = ++reassembly[key];
+    bool complete = (received == flit.sequence_length);
+
+    if (complete) {
+	reassembly.erase(key);
+	reassembly_flits -= received - 1;
+    }
+    else {
+	reassembly_flits++;
+	max_reassembly_flits = max(max_reassembly_flits, reassembly_flits);
+    }
+
+    // Stats take the delay of a packet on its head flit: here on the one
+    // completing the packet, whatever its position
+    Flit sample = flit;
+    sample.flit_type = complete ? FLIT_TYPE_HEAD : FLIT_TYPE_BODY;
+    reassembly_stats->receivedFlit(now, sample);
+
+    return complete;
+}
+
+bool ProcessingElement::canSend(const int vc) const
+{
+    // The router is powered off or waking up
+    if (buffer_full_status_tx.read().gated)
+	return false;
+
+    if (GlobalParams::flow_control == FLOW_CONTROL_CREDIT) {
+	int occupancy[MAX_VIRTUAL_CHANNELS];
+
+	for (int v = 0; v < GlobalParams::n_virtual_channels; v++)
+	    occupancy[v] = credits_used[v] - buffer_full_status_tx.read().credits[v];
+
+	return router_pool.freeSlots(occupancy, vc) > 0;
+    }
+
+    return ack_tx.read() == current_level_tx;
+}
+
+bool ProcessingElement::sourceQueueFull(const Packet & packet) const
+{
+    if (GlobalParams::source_queue_size > 0 &&
+	(int) getQueueSize() >= GlobalParams::source_queue_size)
+	return true;
+
+    if (GlobalParams::source_queue_vc_size > 0 &&
+	vc_queue_occupancy[packet.vc_id] >= GlobalParams::source_queue_vc_size)
+	return true;
+
+    return false;
+}
+
+void ProcessingElement::enqueuePacket(const Packet & packet)
+{
+    if (packet.transaction_type == TRANSACTION_REQUEST)
+	outstanding[packet.transaction_id] = packet.timestamp;
+
+    packet_queue[packet.traffic_class].push(packet);
+    vc_queue_occupancy[packet.vc_id]++;
+}
+
+bool ProcessingElement::collectingStats() const
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+    return (now - GlobalParams::reset_time >= GlobalParams::stats_warm_up_time);
+}
+
+queue < Packet > * ProcessingElement::txQueue()
+{
+    // A packet is sent as a whole, then the lowest class goes first
+    for (unsigned int c = 0; c < packet_queue.size(); c++)
+	if (!packet_queue[c].empty() && packet_queue[c].front().flit_left < packet_queue[c].front().size)
+	    return &packet_queue[c];
+
+    for (unsigned int c = 0; c < packet_queue.size(); c++)
+	if (!packet_queue[c].empty())
+	    return &packet_queue[c];
+
+    return NULL;
+}
+
 Flit ProcessingElement::nextFlit()
 {
     Flit flit;
+    queue < Packet > & packet_queue = *txQueue();
     Packet packet = packet_queue.front();
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
 
     flit.src_id = packet.src_id;
     flit.dst_id = packet.dst_id;
+    flit.dst_set = packet.dst_set;
+
+    // The copies of a multicast sent by the source only reach the core
+    // they are addressed to
+    if (sourceCopies(packet) > 1) {
+	flit.dst_set.reset();
+	flit.dst_set.set(packet.dst_id);
+    }
     flit.vc_id = packet.vc_id;
+    flit.traffic_class = packet.traffic_class;
     flit.timestamp = packet.timestamp;
+    flit.injection_timestamp = now;
     flit.sequence_no = packet.size - packet.flit_left;
     flit.sequence_length = packet.size;
     flit.hop_no = 0;
+    flit.arrival_cycle = now;
+    flit.trace_id = packet.trace_id;
+    flit.transaction_type = packet.transaction_type;
+    flit.transaction_id = packet.transaction_id;
     //  flit.payload     = DEFAULT_PAYLOAD;
 
     flit.hub_relay_node = NOT_VALID;
@@ -80,9 +263,29 @@ Flit ProcessingElement::nextFlit()
     else
 	flit.flit_type = FLIT_TYPE_BODY;
 
+    // Time spent by the packet in the source queue (stall included)
+    if (flit.flit_type == FLIT_TYPE_HEAD && collectingStats()) {
+	double delay = now - packet.timestamp;
+	total_source_delay += delay;
+	source_delay_samples++;
+	if (delay > max_source_delay)
+	    max_source_delay = delay;
+    }
+
     packet_queue.front().flit_left--;
-    if (packet_queue.front().flit_left == 0)
-	packet_queue.pop();
+    if (packet_queue.front().flit_left == 0) {
+	if (sourceCopies(packet) > 1) {
+	    // Next copy of the multicast, from its head again
+	    Packet & front = packet_queue.front();
+	    front.dst_set.reset(front.dst_id);
+	    front.dst_id = firstCore(front.dst_set);
+	    front.flit_left = front.size;
+	}
+	else {
+	    vc_queue_occupancy[packet.vc_id]--;
+	    packet_queue.pop();
+	}
+    }
 
     return flit;
 }
@@ -104,6 +307,11 @@ bool ProcessingElement::canShot(Packet & packet)
 	}
 	//*/
 
+    // Closed-loop sources wait for replies before issuing more requests
+    if (GlobalParams::request_reply && GlobalParams::max_outstanding_requests > 0 &&
+	(int) outstanding.size() >= GlobalParams::max_outstanding_requests)
+	return false;
+
 #ifdef DEADLOCK_AVOIDANCE
     if (local_id%2==0)
 	return false;
@@ -113,7 +321,9 @@ bool ProcessingElement::canShot(Packet & packet)
 
     double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
 
-    if (GlobalParams::traffic_distribution != TRAFFIC_TABLE_BASED) {
+    if (GlobalParams::traffic_distribution == TRAFFIC_TRACE)
+	shot = traceShot(packet);
+    else if (GlobalParams::traffic_distribution != TRAFFIC_TABLE_BASED) {
 	if (!transmittedAtPreviousCycle)
 	    threshold = GlobalParams::packet_injection_rate;
 	else
@@ -141,6 +351,10 @@ bool ProcessingElement::canShot(Packet & packet)
             cout << "Invalid traffic distribution: " << GlobalParams::traffic_distribution << endl;
             exit(-1);
         }
+
+	    // Packets of these distributions are all of class 0
+	    if (!GlobalParams::class_vcs.empty())
+		packet.vc_id = randInt(0, GlobalParams::class_vcs[0] - 1);
 	}
     } else {			// Table based communication traffic
 	if (never_transmit)
@@ -148,25 +362,199 @@ bool ProcessingElement::canShot(Packet & packet)
 
 	bool use_pir = (transmittedAtPreviousCycle == false);
 	vector < pair < int, double > > dst_prob;
+	vector < int > dst_class;
 	double threshold =
-	    traffic_table->getCumulativePirPor(local_id, (int) now, use_pir, dst_prob);
+	    traffic_table->getCumulativePirPor(local_id, (int) now, use_pir, dst_prob, dst_class);
 
 	double prob = (double) rand() / RAND_MAX;
 	shot = (prob < threshold);
 	if (shot) {
 	    for (unsigned int i = 0; i < dst_prob.size(); i++) {
 		if (prob < dst_prob[i].second) {
-                    int vc = randInt(0,GlobalParams::n_virtual_channels-1);
+		    // Any VC of the traffic class of the flow
+		    int first, count;
+		    classVirtualChannels(dst_class[i], first, count);
+                    int vc = randInt(first, first + count - 1);
 		    packet.make(local_id, dst_prob[i].first, vc, now, getRandomSize());
+		    packet.traffic_class = dst_class[i];
 		    break;
 		}
 	    }
 	}
     }
 
+    if (shot && GlobalParams::request_reply) {
+	packet.transaction_type = TRANSACTION_REQUEST;
+	packet.transaction_id = next_transaction++;
+
+	// Memory requests go to a random controller
+	if (!GlobalParams::memory_controller_cores.empty() &&
+	    (double) rand() / RAND_MAX < GlobalParams::memory_traffic_ratio)
+	    packet.dst_id = GlobalParams::memory_controller_cores[rand() % GlobalParams::memory_controller_cores.size()];
+    }
+
+    if (shot && GlobalParams::multicast_rate > 0 &&
+	(double) rand() / RAND_MAX < GlobalParams::multicast_rate)
+	makeMulticast(packet);
+
     return shot;
 }
 
+bool ProcessingElement::traceShot(Packet & packet)
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+    // Closed-loop replay: due packets whose dependency has not been
+    // received yet are set aside, not to hold the following ones
+    while (!trace_cursor.done() && now >= GlobalParams::reset_time + trace_cursor.next->cycle) {
+	const TraceRecord & r = *trace_cursor.next;
+
+	if (r.dst == local_id || r.dst >= TopologyGraph::getInstance()->getCoreCount() || r.size == 0 ||
+	    r.traffic_class >= trafficClasses() ||
+	    (r.dependency != TRACE_NO_DEPENDENCY && r.dependency >= traffic_trace->getPacketCount())) {
+	    cerr << "Error: invalid packet " << trace_cursor.id << " of core " << local_id << " in the trace" << endl;
+	    exit(1);
+	}
+
+	if (!GlobalParams::trace_dependencies || r.dependency == TRACE_NO_DEPENDENCY ||
+	    traffic_trace->isDelivered(r.dependency))
+	    break;
+
+	trace_waiting.push_back(trace_cursor.id);
+	trace_cursor.next++;
+	trace_cursor.id++;
+    }
+
+    // Released packets go first, generated once their dependency is met
+    for (unsigned int k = 0; k < trace_waiting.size(); k++) {
+	uint32_t id = trace_waiting[k];
+
+	if (traffic_trace->isDelivered(traffic_trace->getRecord(id).dependency)) {
+	    trace_waiting.erase(trace_waiting.begin() + k);
+	    makeTracePacket(packet, id, now);
+	    return true;
+	}
+    }
+
+    if (trace_cursor.done() || now < GlobalParams::reset_time + trace_cursor.next->cycle)
+	return false;
+
+    makeTracePacket(packet, trace_cursor.id, GlobalParams::reset_time + trace_cursor.next->cycle);
+    trace_cursor.next++;
+    trace_cursor.id++;
+
+    return true;
+}
+
+void ProcessingElement::makeTracePacket(Packet & packet, const uint32_t id, const double timestamp)
+{
+    const TraceRecord & r = traffic_trace->getRecord(id);
+    int first, count;
+
+    // Packets have a head and a tail flit at least
+    classVirtualChannels(r.traffic_class, first, count);
+    packet.make(local_id, r.dst, randInt(first, first + count - 1), timestamp, max((int) r.size, 2));
+    packet.traffic_class = r.traffic_class;
+    packet.trace_id = id;
+}
+
+bool ProcessingElement::replyReady(Packet & packet)
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+    if (pending_replies.empty() || pending_replies.front().ready > now)
+	return false;
+
+    const PendingReply & reply = pending_replies.front();
+
+    packet.make(local_id, reply.requester, reply.vc_id, reply.ready, GlobalParams::reply_packet_size);
+    packet.traffic_class = reply.traffic_class;
+    packet.transaction_type = TRANSACTION_REPLY;
+    packet.transaction_id = reply.transaction_id;
+
+    return true;
+}
+
+PendingReply ProcessingElement::replyTo(const Flit & request)
+{
+    PendingReply reply;
+    int first, count;
+
+    // The reply takes the traffic class of the request
+    classVirtualChannels(request.traffic_class, first, count);
+    reply.ready = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    reply.requester = request.src_id;
+    reply.transaction_id = request.transaction_id;
+    reply.traffic_class = request.traffic_class;
+    reply.vc_id = randInt(first, first + count - 1);
+
+    return reply;
+}
+
+void ProcessingElement::serveRequest(const Flit & request)
+{
+    PendingReply reply = replyTo(request);
+
+    reply.ready += GlobalParams::reply_service_time;
+    pending_replies.push_back(reply);
+}
+
+void ProcessingElement::receivedTransaction(const Flit & flit)
+{
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+
+    if (flit.transaction_type == TRANSACTION_REQUEST) {
+	serveRequest(flit);
+	return;
+    }
+
+    map < long, double >::iterator it = outstanding.find(flit.transaction_id);
+    assert(it != outstanding.end());
+
+    if (collectingStats()) {
+	double delay = now - it->second;
+	completed_transactions++;
+	total_transaction_delay += delay;
+	if (delay > max_transaction_delay)
+	    max_transaction_delay = delay;
+    }
+
+    outstanding.erase(it);
+}
+
+void ProcessingElement::makeMulticast(Packet & packet)
+{
+    vector < int > others;
+
+    for (int c = 0; c < TopologyGraph::getInstance()->getCoreCount(); c++)
+	if (c != local_id)
+	    others.push_back(c);
+
+    int n = GlobalParams::multicast_destinations;
+    if (n == 0 || n > (int) others.size())
+	n = others.size();
+
+    // The first n cores of a partial shuffle
+    packet.dst_set.reset();
+    for (int k = 0; k < n; k++) {
+	swap(others[k], others[k + rand() % (others.size() - k)]);
+	packet.dst_set.set(others[k]);
+    }
+
+    if (GlobalParams::multicast_replication == MULTICAST_SOURCE)
+	packet.dst_id = firstCore(packet.dst_set);
+    else
+	packet.dst_id = NOT_VALID;
+}
+
+int ProcessingElement::sourceCopies(const Packet & packet) const
+{
+    if (packet.dst_id == NOT_VALID)
+	return 1;
+
+    return max((int) packet.dst_set.count(), 1);
+}
+
 
 Packet ProcessingElement::trafficLocal()
 {
@@ -176,7 +564,7 @@ Packet ProcessingElement::trafficLocal()
 
     vector<int> dst_set;
 
-    int max_id = (GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y);
+    int max_id = TopologyGraph::getInstance()->getCoreCount();
 
     for (int i=0;i<max_id;i++)
     {
@@ -204,12 +592,12 @@ Packet ProcessingElement::trafficLocal()
 
 int ProcessingElement::findRandomDestination(int id, int hops)
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(isMeshTopology());
 
     int inc_y = rand()%2?-1:1;
     int inc_x = rand()%2?-1:1;
     
-    Coord current =  id2Coord(id);
+    Coord current =  coreId2Coord(id);
     
 
 
@@ -219,13 +607,13 @@ int ProcessingElement::findRandomDestination(int id, int hops)
 	if (current.x==0)
 	    if (inc_x<0) inc_x=0;
 
-	if (current.x== GlobalParams::mesh_dim_x-1)
+	if (current.x== coreDimX()-1)
 	    if (inc_x>0) inc_x=0;
 
 	if (current.y==0)
 	    if (inc_y<0) inc_y=0;
 
-	if (current.y==GlobalParams::mesh_dim_y-1)
+	if (current.y==coreDimY()-1)
 	    if (inc_y>0) inc_y=0;
 
 	if (rand()%2)
@@ -233,13 +621,13 @@ int ProcessingElement::findRandomDestination(int id, int hops)
 	else
 	    current.y +=inc_y;
     }
-    return coord2Id(current);
+    return coreCoord2Id(current);
 }
 
 
 int roulette()
 {
-    int slices = GlobalParams::mesh_dim_x + GlobalParams::mesh_dim_y -2;
+    int slices = coreDimX() + coreDimY() -2;
 
 
     double r = rand()/(double)RAND_MAX;
@@ -279,12 +667,7 @@ Packet ProcessingElement::trafficRandom()
     p.src_id = local_id;
     double rnd = rand() / (double) RAND_MAX;
     double range_start = 0.0;
-    int max_id;
-
-    if (GlobalParams::topology == TOPOLOGY_MESH)
-	max_id = (GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y) - 1; //Mesh 
-    else    // other delta topologies
-	max_id = GlobalParams::n_delta_tiles-1; 
+    int max_id = TopologyGraph::getInstance()->getCoreCount() - 1;
 
     // Random destination distribution
     do {
@@ -302,7 +685,7 @@ Packet ProcessingElement::trafficRandom()
 		range_start += GlobalParams::hotspots[i].second;	// try next
 	}
 #ifdef DEADLOCK_AVOIDANCE
-	assert((GlobalParams::topology == TOPOLOGY_MESH));
+	assert(isMeshTopology());
 	if (p.dst_id%2!=0)
 	{
 	    p.dst_id = (p.dst_id+1)%256;
@@ -333,18 +716,18 @@ Packet ProcessingElement::trafficTest()
 
 Packet ProcessingElement::trafficTranspose1()
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(isMeshTopology());
     Packet p;
     p.src_id = local_id;
     Coord src, dst;
 
     // Transpose 1 destination distribution
-    src.x = id2Coord(p.src_id).x;
-    src.y = id2Coord(p.src_id).y;
-    dst.x = GlobalParams::mesh_dim_x - 1 - src.y;
-    dst.y = GlobalParams::mesh_dim_y - 1 - src.x;
+    src.x = coreId2Coord(p.src_id).x;
+    src.y = coreId2Coord(p.src_id).y;
+    dst.x = coreDimX() - 1 - src.y;
+    dst.y = coreDimY() - 1 - src.x;
     fixRanges(src, dst);
-    p.dst_id = coord2Id(dst);
+    p.dst_id = coreCoord2Id(dst);
 
     p.vc_id = randInt(0,GlobalParams::n_virtual_channels-1);
     p.timestamp = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
@@ -355,18 +738,18 @@ Packet ProcessingElement::trafficTranspose1()
 
 Packet ProcessingElement::trafficTranspose2()
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
+    assert(isMeshTopology());
     Packet p;
     p.src_id = local_id;
     Coord src, dst;
 
     // Transpose 2 destination distribution
-    src.x = id2Coord(p.src_id).x;
-    src.y = id2Coord(p.src_id).y;
+    src.x = coreId2Coord(p.src_id).x;
+    src.y = coreId2Coord(p.src_id).y;
     dst.x = src.y;
     dst.y = src.x;
     fixRanges(src, dst);
-    p.dst_id = coord2Id(dst);
+    p.dst_id = coreCoord2Id(dst);
 
     p.vc_id = randInt(0,GlobalParams::n_virtual_channels-1);
     p.timestamp = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
@@ -403,8 +786,8 @@ Packet ProcessingElement::trafficBitReversal()
     int nbits =
 	(int)
 	log2ceil((double)
-		 (GlobalParams::mesh_dim_x *
-		  GlobalParams::mesh_dim_y));
+		 (coreDimX() *
+		  coreDimY()));
     int dnode = 0;
     for (int i = 0; i < nbits; i++)
 	setBit(dnode, i, getBit(local_id, nbits - i - 1));
@@ -426,8 +809,8 @@ Packet ProcessingElement::trafficShuffle()
     int nbits =
 	(int)
 	log2ceil((double)
-		 (GlobalParams::mesh_dim_x *
-		  GlobalParams::mesh_dim_y));
+		 (coreDimX() *
+		  coreDimY()));
     int dnode = 0;
     for (int i = 0; i < nbits - 1; i++)
 	setBit(dnode, i + 1, getBit(local_id, i));
@@ -448,8 +831,8 @@ Packet ProcessingElement::trafficButterfly()
 {
 
     int nbits = (int) log2ceil((double)
-		 (GlobalParams::mesh_dim_x *
-		  GlobalParams::mesh_dim_y));
+		 (coreDimX() *
+		  coreDimY()));
     int dnode = 0;
     for (int i = 1; i < nbits - 1; i++)
 	setBit(dnode, i, getBit(local_id, i));
@@ -475,10 +858,10 @@ void ProcessingElement::fixRanges(const Coord src,
 	dst.x = 0;
     if (dst.y < 0)
 	dst.y = 0;
-    if (dst.x >= GlobalParams::mesh_dim_x)
-	dst.x = GlobalParams::mesh_dim_x - 1;
-    if (dst.y >= GlobalParams::mesh_dim_y)
-	dst.y = GlobalParams::mesh_dim_y - 1;
+    if (dst.x >= coreDimX())
+	dst.x = coreDimX() - 1;
+    if (dst.y >= coreDimY())
+	dst.y = coreDimY() - 1;
 }
 
 int ProcessingElement::getRandomSize()
@@ -489,6 +872,11 @@ int ProcessingElement::getRandomSize()
 
 unsigned int ProcessingElement::getQueueSize() const
 {
-    return packet_queue.size();
+    unsigned int n = 0;
+
+    for (unsigned int c = 0; c < packet_queue.size(); c++)
+	n += packet_queue[c].size();
+
+    return n;
 }
 
@@ -11,15 +11,30 @@
 #ifndef __NOXIMPROCESSINGELEMENT_H__
 #define __NOXIMPROCESSINGELEMENT_H__
 
+#include <deque>
+#include <map>
 #include <queue>
+#include <tuple>
 #include <systemc.h>
 
+#include "Buffer.h"
 #include "DataStructs.h"
 #include "GlobalTrafficTable.h"
+#include "Stats.h"
+#include "TrafficTrace.h"
 #include "Utils.h"
 
 using namespace std;
 
+// PendingReply -- reply to a request being served by its destination
+struct PendingReply {
+    double ready;		// Cycle the reply is generated at
+    int requester;
+    long transaction_id;
+    int traffic_class;
+    int vc_id;
+};
+
 SC_MODULE(ProcessingElement)
 {
 
@@ -38,19 +53,41 @@ SC_MODULE(ProcessingElement)
     sc_in < TBufferFullStatus > buffer_full_status_tx;
 
     sc_in < int >free_slots_neighbor;
+    sc_out < bool > wake_tx;	// Asks the router to wake up, if gated
 
     // Registers
     int local_id;		// Unique identification number
     bool current_level_rx;	// Current level for Alternating Bit Protocol (ABP)
     bool current_level_tx;	// Current level for Alternating Bit Protocol (ABP)
-    queue < Packet > packet_queue;	// Local queue of packets
+    int credits_used[MAX_VIRTUAL_CHANNELS];	// Flits injected on each VC (credit-based flow control)
+    int credits_freed[MAX_VIRTUAL_CHANNELS];	// Flits received on each VC, consumed at once
+    BufferPool router_pool;	// Slots of the router input port fed by the PE
+
+    // Packets delivered out of order (deflection routers) are reassembled
+    // by the PE, which then takes their statistics. NULL if the router
+    // takes them, flits being in order
+    Stats *reassembly_stats;
+    map < tuple < int, double, long, int >, int > reassembly;	// Flits received of each incomplete packet, by source, timestamp, trace index and transaction type
+    int reassembly_flits;	// Flits of the incomplete packets
+    int max_reassembly_flits;
+    vector < queue < Packet > > packet_queue;	// Local queue of packets of each traffic class
+    int vc_queue_occupancy[MAX_VIRTUAL_CHANNELS];	// Queued packets for each VC
+    Packet stalled_packet;	// Packet waiting for room in the source queue
+    bool source_stalled;	// True while stalled_packet is pending
     bool transmittedAtPreviousCycle;	// Used for distributions with memory
 
     // Functions
-    void rxProcess();		// The receiving process
-    void txProcess();		// The transmitting process
-    bool canShot(Packet & packet);	// True when the packet must be shot
+    virtual void rxProcess();	// The receiving process
+    virtual void txProcess();	// The transmitting process
+    bool canSend(const int vc) const;	// True if the flow control lets a flit go on VC vc
+    bool reassemble(const Flit & flit);	// Accounts a flit of a packet delivered out of order, true if it completes it
+    virtual bool canShot(Packet & packet);	// True when the packet must be shot
+    void makeMulticast(Packet & packet);	// Turns packet into a multicast to random cores
+    int sourceCopies(const Packet & packet) const;	// Packets injected by the source for packet
+    queue < Packet > * txQueue();	// Queue of the packet to send, NULL if none
     Flit nextFlit();	// Take the next flit of the current packet
+    bool traceShot(Packet & packet);	// True when the next packet of the trace must be shot
+    void makeTracePacket(Packet & packet, const uint32_t id, const double timestamp);
     Packet trafficTest();	// used for testing traffic
     Packet trafficRandom();	// Random destination distribution
     Packet trafficTranspose1();	// Transpose 1 destination distribution
@@ -65,6 +102,19 @@ SC_MODULE(ProcessingElement)
     bool never_transmit;	// true if the PE does not transmit any packet 
     //  (valid only for the table based traffic)
 
+    TrafficTrace *traffic_trace;	// Trace replayed, NULL if none
+    TraceCursor trace_cursor;	// Packets of the core still to be replayed
+    vector < uint32_t > trace_waiting;	// Due packets of the trace waiting for their dependency
+
+    // Request/reply traffic
+    deque < PendingReply > pending_replies;	// Requests received, by ready cycle of their reply
+    map < long, double > outstanding;	// Generation cycle of the requests waiting for their reply
+    long next_transaction;	// Number of the next request
+    bool replyReady(Packet & packet);	// True when the reply to the oldest pending request is generated
+    void receivedTransaction(const Flit & flit);	// Serves a request, or completes the transaction of a reply
+    virtual void serveRequest(const Flit & request);	// Queues the reply, reply_service_time cycles later
+    PendingReply replyTo(const Flit & request);	// Reply to request, ready now
+
     void fixRanges(const Coord, Coord &);	// Fix the ranges of the destination
     int randInt(int min, int max);	// Extracts a random integer number between min and max
     int getRandomSize();	// Returns a random size in flits for the packet
@@ -76,8 +126,37 @@ SC_MODULE(ProcessingElement)
     int findRandomDestination(int local_id,int hops);
     unsigned int getQueueSize() const;
 
+    // Source queue management
+    bool sourceQueueFull(const Packet & packet) const;
+    void enqueuePacket(const Packet & packet);
+    bool collectingStats() const;	// True once the warm-up is over
+
+    // Source queue statistics (collected after the warm-up)
+    unsigned long offered_packets;	// Packets produced by the traffic source
+    unsigned long offered_flits;
+    unsigned long dropped_packets;	// Packets rejected by a full source queue
+    unsigned long dropped_flits;
+    unsigned long injected_flits;	// Flits accepted by the network
+    unsigned long source_delay_samples;
+    double total_source_delay;	// Generation to injection of head flits (cycles)
+    double max_source_delay;
+
+    // Round trip of the transactions (request/reply traffic), from the
+    // generation of the request to the reception of its reply
+    unsigned long completed_transactions;
+    double total_transaction_delay;
+    double max_transaction_delay;
+
+    virtual ~ProcessingElement() {}
+
     // Constructor
-    SC_CTOR(ProcessingElement) {
+    SC_HAS_PROCESS(ProcessingElement);
+
+    ProcessingElement(sc_module_name nm): sc_module(nm) {
+	reassembly_stats = NULL;
+	traffic_trace = NULL;
+	packet_queue.resize(trafficClasses());
+
 	SC_METHOD(rxProcess);
 	sensitive << reset;
 	sensitive << clock.pos();
@@ -51,11 +51,37 @@ vector<pair<int,int> > ReservationTable::getReservations(const int port_in)
     return reservations;
 }
 
-int ReservationTable::checkReservation(const TReservation r, const int port_out)
+bool ReservationTable::getReservation(const int port_in, const int vc, int & port_out, int & out_vc) const
+{
+    for (int o = 0; o < n_outputs; o++)
+	for (vector<TReservation>::size_type i = 0; i < rtable[o].reservations.size(); i++)
+	    if (rtable[o].reservations[i].input == port_in && rtable[o].reservations[i].vc == vc)
+	    {
+		port_out = o;
+		out_vc = rtable[o].reservations[i].out_vc;
+		return true;
+	    }
+
+    return false;
+}
+
+const vector<TReservation> & ReservationTable::getOutputReservations(const int port_out) const
+{
+    assert(port_out < n_outputs);
+    return rtable[port_out].reservations;
+}
+
+int ReservationTable::getIndex(const int port_out) const
+{
+    assert(port_out < n_outputs);
+    return rtable[port_out].index;
+}
+
+int ReservationTable::checkReservation(const TReservation r, const int port_out, const bool multicast)
 {
     /* Sanity Check for forbidden table status:
      * - same input/VC in a different output line */
-    for (int o=0;o<n_outputs;o++)
+    for (int o=0;o<n_outputs && !multicast;o++)
     {
 	for (vector<TReservation>::size_type i=0;i<rtable[o].reservations.size(); i++)
 	{
@@ -77,9 +103,8 @@ int ReservationTable::checkReservation(const TReservation r, const int port_out)
 	if (rtable[port_out].reservations[i] == r)
 	    return RT_ALREADY_SAME;
 
-	// the same VC for that output has been reserved by another input
-	if (rtable[port_out].reservations[i].input != r.input &&
-	    rtable[port_out].reservations[i].vc == r.vc)
+	// the same VC for that output has been reserved by another input/VC
+	if (rtable[port_out].reservations[i].out_vc == r.out_vc)
 	    return RT_OUTVC_BUSY;
     }
     return RT_AVAILABLE;
@@ -100,13 +125,13 @@ void ReservationTable::print()
 }
 
 
-void ReservationTable::reserve(const TReservation r, const int port_out)
+void ReservationTable::reserve(const TReservation r, const int port_out, const bool multicast)
 {
     // IMPORTANT: problem when used by Hub with more connections
     //
     // reservation of reserved/not valid ports is illegal. Correctness
     // should be assured by ReservationTable users
-    assert(checkReservation(r, port_out)==RT_AVAILABLE);
+    assert(checkReservation(r, port_out, multicast)==RT_AVAILABLE);
 
     // TODO: a better policy could insert in a specific position as far a possible
     // from the current index
@@ -22,6 +22,7 @@ struct TReservation
 {
     int input;
     int vc;
+    int out_vc;		// VC used on the output link (differs from vc across datelines)
     inline bool operator ==(const TReservation & r) const
     {
 	return (r.input==input && r.vc == vc);
@@ -41,19 +42,28 @@ class ReservationTable {
 
     inline string name() const {return "ReservationTable";};
 
-    // check if the input/vc/output is a
-    int checkReservation(const TReservation r, const int port_out);
+    // check if the input/vc/output is a. Multicast packets may hold
+    // several outputs, one for each branch of their tree
+    int checkReservation(const TReservation r, const int port_out, const bool multicast = false);
 
     // Connects port_in with port_out. Asserts if port_out is reserved
-    void reserve(const TReservation r, const int port_out);
+    void reserve(const TReservation r, const int port_out, const bool multicast = false);
 
     // Releases port_out connection. 
     // Asserts if port_out is not reserved or not valid
     void release(const TReservation r, const int port_out);
 
+    // Output port and VC reserved by the packet in port_in/vc, false if none
+    bool getReservation(const int port_in, const int vc, int & port_out, int & out_vc) const;
+
     // Returns the pairs of output port and virtual channel reserved by port_in
     vector<pair<int,int> > getReservations(const int port_int);
 
+    // Returns the reservations of port_out, and the position of the one
+    // having highest priority in the current cycle
+    const vector<TReservation> & getOutputReservations(const int port_out) const;
+    int getIndex(const int port_out) const;
+
     // update the index of the reservation having highest priority in the current cycle
     void updateIndex();
 
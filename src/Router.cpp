@@ -10,16 +10,149 @@
 
 #include "Router.h"
 
+void Router::process()
+{
+    if (power_gating)
+	updatePowerGating();
+
+    // Routers of a slower clock domain skip the nominal cycles without
+    // an edge of their clock
+    bool edge = true;
+
+    if (clock_domain == NULL)
+	local_cycle = (unsigned long) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps);
+    else if (reset.read())
+	local_cycle = 0;
+    else if ((edge = clockEdge()))
+	local_cycle++;
+
+    if (edge && gating_state == GATING_ON)
+	txProcess();
+    rxProcess();
+
+    // Outputs holding reservations need the receiver on
+    if (power_gating)
+	for (int o = 0; o < n_ports; o++)
+	    wake_tx[o].write(!reset.read() && !reservation_table.isNotReserved(o));
+}
+
+void Router::updatePowerGating()
+{
+    if (reset.read()) {
+	gating_state = GATING_ON;
+	idle_cycles = 0;
+	predicted_idle_cycles = 0.0;
+	return;
+    }
+
+    int now = (int) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps);
+
+    if (gating_state == GATING_ON) {
+	if (!isIdle()) {
+	    if (idle_cycles > 0)
+		updateIdlePrediction();
+	    return;
+	}
+
+	idle_cycles++;
+	if (gatingPays()) {
+	    LOG << "Router gated after " << idle_cycles << " idle cycles" << endl;
+	    gating_state = GATING_OFF;
+	}
+    }
+    else if (gating_state == GATING_OFF) {
+	if (wakeupRequested()) {
+	    LOG << "Router waking up" << endl;
+	    updateIdlePrediction();
+	    gating_state = GATING_WAKING;
+	    wakeup_end_cycle = now + GlobalParams::power_gating_wakeup;
+	    power.routerWakeup();
+	}
+	else
+	    idle_cycles++;
+    }
+    else if (now >= wakeup_end_cycle) {
+	gating_state = GATING_ON;
+	idle_cycles = 0;
+    }
+}
 
-inline int toggleKthBit(int n, int k)
+bool Router::gatingPays() const
 {
-	return (n ^ (1 << (k-1)));
+    if (GlobalParams::power_gating == POWER_GATING_TIMEOUT)
+	return idle_cycles >= GlobalParams::power_gating_timeout;
+
+    // The wake-up energy is recovered by idle periods longer than the
+    // break-even time. When the history mispredicts a long period, the
+    // router still gates once it has leaked as much as a wake-up costs
+    double break_even = power.routerBreakEven(leakingBuffers());
+
+    return predicted_idle_cycles > break_even || idle_cycles >= break_even;
 }
 
-void Router::process()
+void Router::updateIdlePrediction()
 {
-    txProcess();
-    rxProcess();
+    // Exponential average, weighting the last idle period as the history
+    predicted_idle_cycles = (predicted_idle_cycles + idle_cycles) / 2.0;
+    idle_cycles = 0;
+}
+
+bool Router::wakeupRequested() const
+{
+    for (int i = 0; i < n_ports; i++)
+	if (wake_rx[i].read() || req_rx[i].read() != current_level_rx[i])
+	    return true;
+
+    return hasBufferedFlits();
+}
+
+bool Router::hasBufferedFlits() const
+{
+    for (int i = 0; i < n_ports; i++)
+	for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+	    if (!buffer[i][vc].IsEmpty())
+		return true;
+
+    return false;
+}
+
+bool Router::clockEdge()
+{
+    long cycle = (long) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps);
+
+    if (!clock_domain->edge(cycle))
+	return false;
+
+    // Utilization of the domain, for the DVFS policy
+    clock_domain->ticks++;
+    clock_domain->period_ticks++;
+    if (hasBufferedFlits())
+	clock_domain->busy_ticks++;
+
+    return true;
+}
+
+bool Router::isIdle() const
+{
+    if (wakeupRequested())
+	return false;
+
+    for (int o = 0; o < n_ports; o++)
+	if (!reservation_table.getOutputReservations(o).empty())
+	    return false;
+
+    return true;
+}
+
+int Router::leakingBuffers() const
+{
+    int buffers = 0;
+
+    for (int i = 0; i < n_ports; i++)
+	if (i != DIRECTION_HUB && hasInputBuffer(i))
+	    buffers += buffer_pool[i].isShared() ? 1 : GlobalParams::n_virtual_channels;
+
+    return buffers;
 }
 
 void Router::rxProcess()
@@ -27,20 +160,24 @@ void Router::rxProcess()
     if (reset.read()) {
 	TBufferFullStatus bfs;
 	// Clear outputs and indexes of receiving protocol
-	for (int i = 0; i < DIRECTIONS + 2; i++) {
+	for (int i = 0; i < n_ports; i++) {
 	    ack_rx[i].write(0);
 	    current_level_rx[i] = 0;
 	    buffer_full_status_rx[i].write(bfs);
 	}
 	routed_flits = 0;
 	local_drained = 0;
+	sa_matched = 0;
+	sa_max_matching = 0;
+	for (int i = 0; i < n_ports; i++)
+	    tx_flits[i] = 0;
     } 
     else 
     { 
 	// This process simply sees a flow of incoming flits. All arbitration
 	// and wormhole related issues are addressed in the txProcess()
 	//assert(false);
-	for (int i = 0; i < DIRECTIONS + 2; i++) {
+	for (int i = 0; i < n_ports; i++) {
 	    // To accept a new flit, the following conditions must match:
 	    // 1) there is an incoming request
 	    // 2) there is a free slot in the input buffer of direction i
@@ -57,17 +194,19 @@ void Router::rxProcess()
 		{
 
 		    // Store the incoming flit in the circular buffer
+		    received_flit.arrival_cycle = local_cycle + cdc_delay[i];
 		    buffer[i][vc].Push(received_flit);
 		    LOG << " Flit " << received_flit << " collected from Input[" << i << "][" << vc <<"]" << endl;
 
-		    power.bufferRouterPush();
+		    if (hasInputBuffer(i))
+			power.bufferRouterPush();
 
 		    // Negate the old value for Alternating Bit Protocol (ABP)
 		    //LOG<<"INVERTING CL FROM "<< current_level_rx[i]<< " TO "<<  1 - current_level_rx[i]<<endl;
 		    current_level_rx[i] = 1 - current_level_rx[i];
 
 		    // if a new flit is injected from local PE
-		    if (received_flit.src_id == local_id)
+		    if (isLocalPort(i))
 			power.networkInterface();
 		}
 
@@ -75,16 +214,21 @@ void Router::rxProcess()
 		{
 		    // should not happen with the new TBufferFullStatus control signals    
 		    // except for flit coming from local PE, which don't use it 
+		    // unless credits are used
 		    LOG << " Flit " << received_flit << " buffer full Input[" << i << "][" << vc <<"]" << endl;
-		    assert(i== DIRECTION_LOCAL);
+		    assert(isLocalPort(i) && !credit_flow_control);
 		}
 
 	    }
 	    ack_rx[i].write(current_level_rx[i]);
 	    // updates the mask of VCs to prevent incoming data on full buffers
 	    TBufferFullStatus bfs;
-	    for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++)
+	    for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++) {
 		bfs.mask[vc] = buffer[i][vc].IsFull();
+		bfs.free_slots[vc] = buffer[i][vc].getCurrentFreeSlots();
+		bfs.credits[vc] = credits_freed[i][vc];
+	    }
+	    bfs.gated = (gating_state != GATING_ON);
 	    buffer_full_status_rx[i].write(bfs);
 	}
     }
@@ -96,46 +240,69 @@ void Router::txProcess()
   if (reset.read()) 
     {
       // Clear outputs and indexes of transmitting protocol
-      for (int i = 0; i < DIRECTIONS + 2; i++) 
+      for (int i = 0; i < n_ports; i++) 
 	{
 	  req_tx[i].write(0);
 	  current_level_tx[i] = 0;
+	  link_free_cycle[i] = 0;
+	  sa_input_ptr[i] = 0;
+	  sa_output_ptr[i] = 0;
+	  sa_vc_ptr[i] = 0;
+	  va_ptr[i] = 0;
+	  for (int vc = 0; vc < MAX_VIRTUAL_CHANNELS; vc++)
+	  {
+	      credits_used[i][vc] = credits_freed[i][vc] = 0;
+	      multicast_tree[i][vc].clear();
+	  }
 	}
+      sa_priority = 0;
+      active_multicasts = 0;
     } 
   else 
     { 
       // 1st phase: Reservation
-      for (int j = 0; j < DIRECTIONS + 2; j++) 
+      for (int j = 0; j < n_ports; j++) 
 	{
-	  int i = (start_from_port + j) % (DIRECTIONS + 2);
+	  int i = (start_from_port + j) % n_ports;
 
 	  for (int k = 0;k < GlobalParams::n_virtual_channels; k++)
 	  {
 	      int vc = (start_from_vc[i]+k)%(GlobalParams::n_virtual_channels);
-	      
-	      // Uncomment to enable deadlock checking on buffers. 
-	      // Please also set the appropriate threshold.
-	      // buffer[i].deadlockCheck();
 
 	      if (!buffer[i][vc].IsEmpty()) 
 	      {
 		  Flit flit = buffer[i][vc].Front();
 		  power.bufferRouterFront();
 
-		  if (flit.flit_type == FLIT_TYPE_HEAD) 
+		  if (flit.flit_type == FLIT_TYPE_HEAD && pipelineDone(flit, PIPELINE_VA))
 		    {
+		      // Multicast heads reserve their whole tree
+		      if (flit.dst_id == NOT_VALID)
+		      {
+			  if (multicast_tree[i][vc].empty())
+			      reserveMulticast(flit, i, vc);
+			  continue;
+		      }
+
 		      // prepare data for routing
 		      RouteData route_data;
 		      route_data.current_id = local_id;
 		      //LOG<< "current_id= "<< route_data.current_id <<" for sending " << flit << endl;
-		      route_data.src_id = flit.src_id;
-		      route_data.dst_id = flit.dst_id;
+		      // Routing works on the routers the cores are attached to
+		      TopologyGraph * graph = TopologyGraph::getInstance();
+		      route_data.src_id = graph->getCoreNode(flit.src_id);
+		      route_data.dst_id = graph->getCoreNode(flit.dst_id);
 		      route_data.dir_in = i;
 		      route_data.vc_id = flit.vc_id;
+		      route_data.traffic_class = flit.traffic_class;
 
 		      // TODO: see PER POSTERI (adaptive routing should not recompute route if already reserved)
 		      int o = route(route_data);
 
+		      // each core attached to the router has its own local port
+		      if (o == DIRECTION_LOCAL)
+			  o = local_port[graph->getCoreIndex(flit.dst_id)];
+
 		      // manage special case of target hub not directly connected to destination
 		      if (o>=DIRECTION_HUB_RELAY)
 			  {
@@ -151,7 +318,19 @@ void Router::txProcess()
 
 		      LOG << " checking availability of Output[" << o << "] for Input[" << i << "][" << vc << "] flit " << flit << endl;
 
-		      int rt_status = reservation_table.checkReservation(r,o);
+		      int rt_status = checkOutput(route_data, o, r);
+
+		      // Duato's protocol: a packet finding no free VC on the
+		      // selected output falls back on the escape route
+		      if (rt_status == RT_OUTVC_BUSY && dynamic_vcs && !isLocalPort(o) && o != DIRECTION_HUB)
+		      {
+			  int escape = routingAlgorithm->escapeDirection(route_data);
+			  if (escape != NOT_VALID && escape != o)
+			  {
+			      o = escape;
+			      rt_status = checkOutput(route_data, o, r);
+			  }
+		      }
 
 		      if (rt_status == RT_AVAILABLE) 
 		      {
@@ -177,100 +356,338 @@ void Router::txProcess()
 	    start_from_vc[i] = (start_from_vc[i]+1)%GlobalParams::n_virtual_channels;
 	}
 
-      start_from_port = (start_from_port + 1) % (DIRECTIONS + 2);
+      start_from_port = (start_from_port + 1) % n_ports;
 
-      // 2nd phase: Forwarding
-      //if (local_id==6) LOG<<"*TX*****local_id="<<local_id<<"__ack_tx[0]= "<<ack_tx[0].read()<<endl;
-      for (int i = 0; i < DIRECTIONS + 2; i++) 
-      { 
-	  vector<pair<int,int> > reservations = reservation_table.getReservations(i);
-	  
-	  if (reservations.size()!=0)
-	  {
+      // 2nd phase: Switch allocation. Each input VC holding a
+      // reservation requests its output
+      vector<SARequest> requests;
+
+      // Multicast packets move on all their branches at once. Those
+      // whose branches can all take the flit claim the outputs, which
+      // are not requested by the other input VCs in this cycle
+      vector<bool> claimed;
+      vector<bool> multicast_ready;
 
-	      int rnd_idx = rand()%reservations.size();
+      if (active_multicasts > 0)
+      {
+	  claimed.assign(n_ports, false);
+	  multicast_ready.assign(n_ports * MAX_VIRTUAL_CHANNELS, false);
+
+	  for (int j = 0; j < n_ports; j++)
+	  {
+	      int i = (start_from_port + j) % n_ports;
 
-	      int o = reservations[rnd_idx].first;
-	      int vc = reservations[rnd_idx].second;
-	     // LOG<< "found reservation from input= " << i << "_to output= "<<o<<endl;
-	      // can happen
-	      if (!buffer[i][vc].IsEmpty())  
+	      for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
 	      {
-		  // power contribution already computed in 1st phase
-		  Flit flit = buffer[i][vc].Front();
-		  //LOG<< "*****TX***Direction= "<<i<< "************"<<endl;
-		  //LOG<<"_cl_tx="<<current_level_tx[o]<<"req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
-		  
-		  if ( (current_level_tx[o] == ack_tx[o].read()) &&
-		       (buffer_full_status_tx[o].read().mask[vc] == false) ) 
-		  {
-		      //if (GlobalParams::verbose_mode > VERBOSE_OFF) 
-		      LOG << "Input[" << i << "][" << vc << "] forwarded to Output[" << o << "], flit: " << flit << endl;
-
-		      flit_tx[o].write(flit);
-		      current_level_tx[o] = 1 - current_level_tx[o];
-		      req_tx[o].write(current_level_tx[o]);
-		      buffer[i][vc].Pop();
-
-		      if (flit.flit_type == FLIT_TYPE_TAIL)
-		      {
-			  TReservation r;
-			  r.input = i;
-			  r.vc = vc;
-			  reservation_table.release(r,o);
-		      }
+		  const vector<MulticastBranch> & tree = multicast_tree[i][vc];
+		  const Buffer & b = buffer[i][vc];
 
-		      /* Power & Stats ------------------------------------------------- */
-		      if (o == DIRECTION_HUB) power.r2hLink();
-		      else
-			  power.r2rLink();
+		  if (tree.empty() || b.IsEmpty() || !pipelineDone(b.Front(), PIPELINE_ST))
+		      continue;
 
-		      power.bufferRouterPop();
-		      power.crossBar();
+		  // The room for the packet is there since the reservation
+		  bool ready = true;
+		  for (unsigned int k = 0; k < tree.size() && ready; k++)
+		      ready = !claimed[tree[k].output] && canSend(tree[k].output, tree[k].out_vc);
 
-		      if (o == DIRECTION_LOCAL) 
-		      {
-			  power.networkInterface();
-			  LOG << "Consumed flit " << flit << endl;
-			  stats.receivedFlit(sc_time_stamp().to_double() / GlobalParams::clock_period_ps, flit);
-			  if (GlobalParams:: max_volume_to_be_drained) 
-			  {
-			      if (drained_volume >= GlobalParams:: max_volume_to_be_drained)
-				  sc_stop();
-			      else 
-			      {
-				  drained_volume++;
-				  local_drained++;
-			      }
-			  }
-		      } 
-		      else if (i != DIRECTION_LOCAL) // not generated locally
-			  routed_flits++;
-		      /* End Power & Stats ------------------------------------------------- */
-			 //LOG<<"END_OK_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
-		  }
-		  else
-		  {
-		      LOG << " Cannot forward Input[" << i << "][" << vc << "] to Output[" << o << "], flit: " << flit << endl;
-		      //LOG << " **DEBUG APB: current_level_tx: " << current_level_tx[o] << " ack_tx: " << ack_tx[o].read() << endl;
-		      LOG << " **DEBUG buffer_full_status_tx " << buffer_full_status_tx[o].read().mask[vc] << endl;
-
-		  	//LOG<<"END_NO_cl_tx="<<current_level_tx[o]<<"_req_tx="<<req_tx[o].read()<<" _ack= "<<ack_tx[o].read()<< endl;
-		      /*
-		      if (flit.flit_type == FLIT_TYPE_HEAD)
-			  reservation_table.release(i,flit.vc_id,o);
-			  */
-		  }
+		  if (!ready)
+		      continue;
+
+		  multicast_ready[i * MAX_VIRTUAL_CHANNELS + vc] = true;
+		  for (unsigned int k = 0; k < tree.size(); k++)
+		      claimed[tree[k].output] = true;
+	      }
+	  }
+      }
+
+      for (int o = 0; o < n_ports; o++)
+      {
+	  const vector<TReservation> & reservations = reservation_table.getOutputReservations(o);
+
+	  for (unsigned int k = 0; k < reservations.size(); k++)
+	  {
+	      SARequest q;
+	      q.input = reservations[k].input;
+	      q.vc = reservations[k].vc;
+	      q.output = o;
+	      q.out_vc = reservations[k].out_vc;
+	      q.current = ((int) k == reservation_table.getIndex(o));
+	      q.tail = false;
+
+	      const vector<MulticastBranch> & tree = multicast_tree[q.input][q.vc];
+
+	      if (!tree.empty())
+	      {
+		  // A single request, on the first branch, for the tree
+		  if (o != tree[0].output)
+		      continue;
+		  q.ready = multicast_ready[q.input * MAX_VIRTUAL_CHANNELS + q.vc];
+	      }
+	      else
+	      {
+		  const Buffer & b = buffer[q.input][q.vc];
+		  q.ready = !b.IsEmpty() && pipelineDone(b.Front(), PIPELINE_ST) && canSend(o, q.out_vc) &&
+		      (claimed.empty() || !claimed[o]);
+		  q.tail = !b.IsEmpty() && b.Front().flit_type == FLIT_TYPE_TAIL;
 	      }
-	  } // if not reserved 
-	 // else LOG<<"we have no reservation for direction "<<i<< endl;
-      } // for loop directions
 
-      if ((int)(sc_time_stamp().to_double() / GlobalParams::clock_period_ps)%2==0)
+	      requests.push_back(q);
+	  }
+      }
+
+      vector<int> grants = switchAllocator->allocate(this, requests);
+
+      if (requests.size() != 0)
+      {
+	  sa_matched += grants.size();
+	  sa_max_matching += SwitchAllocator::maximumMatching(requests);
+      }
+
+      // 3rd phase: Forwarding
+      for (unsigned int g = 0; g < grants.size(); g++)
+      {
+	  int i = requests[grants[g]].input;
+	  int vc = requests[grants[g]].vc;
+	  int o = requests[grants[g]].output;
+	  int out_vc = requests[grants[g]].out_vc;
+
+	  if (!multicast_tree[i][vc].empty())
+	  {
+	      forwardMulticast(i, vc);
+	      continue;
+	  }
+
+	  // power contribution already computed in 1st phase
+	  Flit flit = buffer[i][vc].Front();
+
+	  LOG << "Input[" << i << "][" << vc << "] forwarded to Output[" << o << "][" << out_vc << "], flit: " << flit << endl;
+
+	  flit.vc_id = out_vc;
+	  if (o != DIRECTION_HUB && !isLocalPort(o))
+	      flit.hop_no++;
+	  flit_tx[o].write(flit);
+	  tx_flits[o]++;
+	  current_level_tx[o] = 1 - current_level_tx[o];
+	  req_tx[o].write(current_level_tx[o]);
+	  credits_used[o][out_vc]++;
+	  linkSent(o);
+	  buffer[i][vc].Pop();
+	  credits_freed[i][vc]++;
+
+	  if (flit.flit_type == FLIT_TYPE_TAIL)
+	  {
+	      TReservation r;
+	      r.input = i;
+	      r.vc = vc;
+	      r.out_vc = out_vc;
+	      reservation_table.release(r,o);
+	  }
+
+	  /* Power & Stats ------------------------------------------------- */
+	  if (o == DIRECTION_HUB) power.r2hLink();
+	  else
+	      power.r2rLink(o);
+
+	  power.bufferRouterPop();
+	  power.crossBar();
+
+	  if (isLocalPort(o)) 
+	  {
+	      stats[local_index[o]].receivedFlit(sc_time_stamp().to_double() / GlobalParams::clock_period_ps, flit);
+	      drainFlit(o, flit);
+	  } 
+	  else if (!isLocalPort(i)) // not generated locally
+	      routed_flits++;
+	  /* End Power & Stats ------------------------------------------------- */
+      }
+
+      if (local_cycle % 2 == 0)
 	  reservation_table.updateIndex();
     }   
 }
 
+vector < MulticastBranch > Router::multicastRoute(const Flit & flit, int in)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    vector < MulticastBranch > branches;
+    map < int, int > node_output;	// Output towards each destination router
+
+    RouteData route_data;
+    route_data.current_id = local_id;
+    route_data.src_id = graph->getCoreNode(flit.src_id);
+    route_data.dir_in = in;
+    route_data.vc_id = flit.vc_id;
+    route_data.traffic_class = flit.traffic_class;
+
+    for (int c = 0; c < graph->getCoreCount(); c++)
+    {
+	if (!flit.dst_set.test(c))
+	    continue;
+
+	int node = graph->getCoreNode(c);
+	int o;
+
+	if (node == local_id)
+	    o = local_port[graph->getCoreIndex(c)];
+	else if (node_output.count(node))
+	    o = node_output[node];
+	else
+	{
+	    route_data.dst_id = node;
+	    o = node_output[node] = route(route_data);
+	}
+
+	unsigned int b = 0;
+	while (b < branches.size() && branches[b].output < o)
+	    b++;
+
+	if (b == branches.size() || branches[b].output != o)
+	{
+	    MulticastBranch branch;
+	    branch.output = o;
+	    branch.out_vc = NOT_VALID;
+	    branches.insert(branches.begin() + b, branch);
+	}
+	branches[b].dst_set.set(c);
+    }
+
+    return branches;
+}
+
+void Router::reserveMulticast(const Flit & flit, int in, int vc)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    vector < MulticastBranch > tree = multicastRoute(flit, in);
+    vector < TReservation > reservations(tree.size());
+
+    RouteData route_data;
+    route_data.current_id = local_id;
+    route_data.src_id = graph->getCoreNode(flit.src_id);
+    route_data.dir_in = in;
+    route_data.vc_id = flit.vc_id;
+    route_data.traffic_class = flit.traffic_class;
+
+    // The tree takes all its outputs at once, each with room for the
+    // whole packet downstream (virtual cut-through), or none of them.
+    // Once reserved it never stops halfway: trees holding some outputs
+    // while waiting for others may wait for each other in a cycle
+    for (unsigned int b = 0; b < tree.size(); b++)
+    {
+	int o = tree[b].output;
+
+	route_data.dst_id = graph->getCoreNode(firstCore(tree[b].dst_set));
+	reservations[b].input = in;
+	reservations[b].vc = vc;
+
+	if (checkOutput(route_data, o, reservations[b]) != RT_AVAILABLE ||
+	    (!isLocalPort(o) && downstreamFreeSlots(o, reservations[b].out_vc) < flit.sequence_length))
+	{
+	    LOG << " multicast flit " << flit << " waiting for Output[" << o << "]" << endl;
+	    return;
+	}
+	tree[b].out_vc = reservations[b].out_vc;
+    }
+
+    for (unsigned int b = 0; b < tree.size(); b++)
+    {
+	LOG << " reserving direction " << tree[b].output << " for multicast flit " << flit << endl;
+	reservation_table.reserve(reservations[b], tree[b].output, true);
+    }
+
+    multicast_tree[in][vc] = tree;
+    active_multicasts++;
+}
+
+void Router::forwardMulticast(int in, int vc)
+{
+    vector < MulticastBranch > & tree = multicast_tree[in][vc];
+    double now = sc_time_stamp().to_double() / GlobalParams::clock_period_ps;
+    Flit flit = buffer[in][vc].Pop();
+
+    credits_freed[in][vc]++;
+    power.bufferRouterPop();
+
+    for (unsigned int b = 0; b < tree.size(); b++)
+    {
+	int o = tree[b].output;
+	Flit copy = flit;
+
+	copy.vc_id = tree[b].out_vc;
+	copy.dst_set = tree[b].dst_set;
+
+	// Copies delivered to a core are addressed to it
+	if (isLocalPort(o))
+	    copy.dst_id = firstCore(copy.dst_set);
+	else
+	    copy.hop_no++;
+
+	LOG << "Input[" << in << "][" << vc << "] forwarded to Output[" << o << "][" << copy.vc_id << "], flit: " << copy << endl;
+
+	flit_tx[o].write(copy);
+	tx_flits[o]++;
+	current_level_tx[o] = 1 - current_level_tx[o];
+	req_tx[o].write(current_level_tx[o]);
+	credits_used[o][copy.vc_id]++;
+	linkSent(o);
+
+	if (flit.flit_type == FLIT_TYPE_TAIL)
+	{
+	    TReservation r;
+	    r.input = in;
+	    r.vc = vc;
+	    r.out_vc = copy.vc_id;
+	    reservation_table.release(r, o);
+	}
+
+	power.r2rLink(o);
+	power.crossBar();
+
+	if (isLocalPort(o))
+	{
+	    stats[local_index[o]].receivedFlit(now, copy);
+	    drainFlit(o, copy);
+	}
+	else if (!isLocalPort(in))
+	    routed_flits++;
+    }
+
+    if (flit.flit_type == FLIT_TYPE_TAIL)
+    {
+	tree.clear();
+	active_multicasts--;
+    }
+}
+
+void Router::drainFlit(int o, const Flit & flit)
+{
+    power.networkInterface();
+    LOG << "Consumed flit " << flit << endl;
+
+    if (GlobalParams:: max_volume_to_be_drained)
+    {
+	if (drained_volume >= GlobalParams:: max_volume_to_be_drained)
+	    sc_stop();
+	else
+	{
+	    drained_volume++;
+	    local_drained++;
+	}
+    }
+}
+
+bool Router::pipelineDone(const Flit & flit, const int unit) const
+{
+    double age = local_cycle - flit.arrival_cycle;
+    int stages = GlobalParams::pipeline_stage[unit];
+
+    // Body and tail flits follow the route and the VC of the head, so
+    // they only go through switch allocation and traversal
+    if (flit.flit_type != FLIT_TYPE_HEAD)
+	stages -= GlobalParams::pipeline_stage[PIPELINE_SA] - 1;
+
+    return age >= stages;
+}
+
 NoP_data Router::getCurrentNoPData()
 {
     NoP_data NoP_data;
@@ -295,17 +712,27 @@ NoP_data Router::getCurrentNoPData()
 void Router::perCycleUpdate()
 {
     if (reset.read()) {
-	for (int i = 0; i < DIRECTIONS + 1; i++)
+	for (int i = 0; i < n_ports; i++)
 	    free_slots[i].write(buffer[i][DEFAULT_VC].GetMaxBufferSize());
     } else {
         selectionStrategy->perCycleUpdate(this);
 
+	if (gating_state == GATING_OFF) {
+	    power.routerGated();
+	    return;
+	}
+
 	power.leakageRouter();
-	for (int i = 0; i < DIRECTIONS + 1; i++)
+	for (int i = 0; i < n_ports; i++)
 	{
+	    if (i == DIRECTION_HUB)
+		continue;
+
 	    for (int vc=0;vc<GlobalParams::n_virtual_channels;vc++)
 	    {
-		power.leakageBufferRouter();
+		// A single memory for the VCs of DAMQ ports
+		if (hasInputBuffer(i) && (vc == 0 || !buffer_pool[i].isShared()))
+		    power.leakageBufferRouter();
 		power.leakageLinkRouter2Router();
 	    }
 	}
@@ -316,77 +743,29 @@ void Router::perCycleUpdate()
 
 vector<int> Router::nextDeltaHops(RouteData rd) {
 
-	if (GlobalParams::topology == TOPOLOGY_MESH)
+	if (isMeshTopology())
 	{
 		cout << "Mesh topologies are not supported for nextDeltaHops() ";
 		assert(false);
 	}
-	// annotate the initial nodes
-	int src = rd.src_id;
-	int dst = rd.dst_id;
 
-	int current_node = src;
-	vector<int> direction; // initially is empty
+	// Follow the destination-tag routing from the source core, through
+	// the switch of each stage, up to the destination core
+	TopologyGraph * graph = TopologyGraph::getInstance();
 	vector<int> next_hops;
+	int current_node = rd.src_id;
 
-	int sw = GlobalParams::n_delta_tiles/2; //sw: switch number in each stage
-	int stg = log2(GlobalParams::n_delta_tiles);
-	int c;
-	//---From Source to stage 0 (return the sw attached to the source)---
-	//Topology omega 
-	if (GlobalParams::topology == TOPOLOGY_OMEGA) 	
-	{
-	if(current_node < (GlobalParams::n_delta_tiles/2))	
-		 c = current_node;
-	else if(current_node >= (GlobalParams::n_delta_tiles/2))	
-		 c = (current_node - (GlobalParams::n_delta_tiles/2));		
-	}
-	//Other delta topologies: Butterfly and baseline
-	else if ((GlobalParams::topology == TOPOLOGY_BUTTERFLY)||(GlobalParams::topology == TOPOLOGY_BASELINE))
-	{
-		 c =  (current_node >>1);
-	}
-
-		Coord temp_coord;
-		temp_coord.x = 0;
-		temp_coord.y = c;
-		int N = coord2Id(temp_coord);
-
-		next_hops.push_back(N);
-		current_node = N;
-	
-	
-   //---From stage 0 to Destination---
-	int current_stage = 0;
-
-	while (current_stage<stg-1)
+	while (current_node != rd.dst_id)
 	{
-		Coord new_coord;
-		int y = id2Coord(current_node).y;
-
 		rd.current_id = current_node;
-		direction = routingAlgorithm->route(this, rd);
-
-		int bit_to_check = stg - current_stage - 1;
-
-		int bit_checked = (y & (1 << (bit_to_check - 1)))>0 ? 1:0;
+		vector<int> direction = routingAlgorithm->route(this, rd);
 
-		// computes next node coords
-		new_coord.x = current_stage + 1;
-		if (bit_checked ^ direction[0])
-			new_coord.y = toggleKthBit(y, bit_to_check);
-		else
-			new_coord.y = y;
-
-		current_node = coord2Id(new_coord);
+		current_node = graph->getNeighbor(current_node, direction[0]);
+		assert(current_node != NOT_VALID);
 		next_hops.push_back(current_node);
-		current_stage = id2Coord(current_node).x;
 	}
 
-	next_hops.push_back(dst);
-
 	return next_hops;
-
 }
 
 vector < int > Router::routingFunction(const RouteData & route_data)
@@ -509,6 +888,18 @@ int Router::selectionFunction(const vector < int >&directions,
     if (directions.size() == 1)
 	return directions[0];
 
+    // Adaptive routes avoid the neighbors which are gated, if they can
+    if (power_gating) {
+	vector < int > powered;
+
+	for (unsigned int k = 0; k < directions.size(); k++)
+	    if (!buffer_full_status_tx[directions[k]].read().gated)
+		powered.push_back(directions[k]);
+
+	if (!powered.empty() && powered.size() < directions.size())
+	    return selectionFunction(powered, route_data);
+    }
+
     return selectionStrategy->apply(this, directions, route_data);
 }
 
@@ -518,7 +909,27 @@ void Router::configure(const int _id,
 			    GlobalRoutingTable & grt)
 {
     local_id = _id;
-    stats.configure(_id, _warm_up_time);
+
+    // Concentrated routers have an additional local port for each core
+    // after the first one
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    const TopologyNode & tn = graph->getNode(_id);
+    const vector < int > & cores = tn.cores;
+
+    assert(tn.radix == n_ports);
+
+    n_local = cores.size();
+
+    for (int k = 0; k < MAX_CONCENTRATION; k++)
+	stats[k].configure((k < n_local) ? cores[k] : _id, _warm_up_time);
+
+    for (int i = 0; i < n_ports; i++)
+	local_index[i] = NOT_VALID;
+    for (unsigned int k = 0; k < tn.local_ports.size(); k++)
+    {
+	local_port[k] = tn.local_ports[k];
+	local_index[tn.local_ports[k]] = k;
+    }
 
     start_from_port = DIRECTION_LOCAL;
   
@@ -526,9 +937,11 @@ void Router::configure(const int _id,
     if (grt.isValid())
 	routing_table.configure(grt, _id);
 
-    reservation_table.setSize(DIRECTIONS+2);
+    reservation_table.setSize(n_ports);
+    multicast_tree.assign(n_ports, vector < vector < MulticastBranch > > (MAX_VIRTUAL_CHANNELS));
+    active_multicasts = 0;
 
-    for (int i = 0; i < DIRECTIONS + 2; i++)
+    for (int i = 0; i < n_ports; i++)
     {
 	for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
 	{
@@ -536,27 +949,59 @@ void Router::configure(const int _id,
 	    buffer[i][vc].setLabel(string(name())+"->buffer["+i_to_string(i)+"]");
 	}
 	start_from_vc[i] = 0;
+
+	buffer_pool[i].configure(tn.damq);
+	if (tn.damq)
+	    for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+		buffer[i][vc].setPool(&buffer_pool[i], vc);
+
+	// PEs consume flits at once, they are given private buffers
+	int neighbor = graph->getNeighbor(_id, i);
+	downstream_pool[i].configure(neighbor != NOT_VALID && graph->getNode(neighbor).damq);
     }
 
 
-    if (GlobalParams::topology == TOPOLOGY_MESH)
-    {
-	int row = _id / GlobalParams::mesh_dim_x;
-	int col = _id % GlobalParams::mesh_dim_x;
+    // Disable the buffers of the input ports not connected to any link
+    for (int i = 0; i < n_ports; i++)
+	if (graph->isNetworkPort(_id, i) && !graph->hasInput(_id, i))
+	    for (int vc = 0; vc<GlobalParams::n_virtual_channels; vc++)
+		buffer[i][vc].Disable();
 
-	for (int vc = 0; vc<GlobalParams::n_virtual_channels; vc++)
-	{
-	    if (row == 0)
-	      buffer[DIRECTION_NORTH][vc].Disable();
-	    if (row == GlobalParams::mesh_dim_y-1)
-	      buffer[DIRECTION_SOUTH][vc].Disable();
-	    if (col == 0)
-	      buffer[DIRECTION_WEST][vc].Disable();
-	    if (col == GlobalParams::mesh_dim_x-1)
-	      buffer[DIRECTION_EAST][vc].Disable();
-	}
+    dateline_vcs = graph->hasDatelines();
+    dynamic_vcs = (GlobalParams::vc_allocation == VC_ALLOCATION_DYNAMIC);
+    credit_flow_control = (GlobalParams::flow_control == FLOW_CONTROL_CREDIT);
+    for (int o = 0; o < n_ports; o++)
+	dateline[o] = graph->isDateline(_id, o);
+
+    power_gating = (GlobalParams::power_gating != POWER_GATING_NONE);
+    gating_state = GATING_ON;
+    idle_cycles = 0;
+    predicted_idle_cycles = 0.0;
+
+    clock_domain = NULL;
+    local_cycle = 0;
+    for (int i = 0; i < n_ports; i++)
+	cdc_delay[i] = 0;
+
+    for (int o = 0; o < n_ports; o++) {
+	serialization[o] = graph->getLinkSerialization(_id, o);
+	link_free_cycle[o] = 0;
     }
+}
+
+void Router::setClockDomain(DVFSController * dvfs)
+{
+    TopologyGraph * graph = TopologyGraph::getInstance();
 
+    clock_domain = dvfs->getDomain(local_id);
+
+    // PEs and hubs are synchronous to the router
+    for (int i = 0; i < n_ports; i++) {
+	int neighbor = graph->getInputNeighbor(local_id, i);
+
+	if (neighbor != NOT_VALID && !dvfs->sameDomain(neighbor, local_id))
+	    cdc_delay[i] = GlobalParams::cdc_sync_cycles;
+    }
 }
 
 unsigned long Router::getRoutedFlits()
@@ -564,6 +1009,18 @@ unsigned long Router::getRoutedFlits()
     return routed_flits;
 }
 
+unsigned long Router::getBufferBits() const
+{
+    unsigned long bits = 0;
+
+    // As in the leakage, all the ports but the hub one
+    for (int i = 0; i < n_ports; i++)
+	if (hasInputBuffer(i))
+	    bits += buffer_pool[i].storageBits(GlobalParams::flit_size);
+
+    return bits;
+}
+
 
 int Router::reflexDirection(int direction) const
 {
@@ -581,41 +1038,172 @@ int Router::reflexDirection(int direction) const
     return NOT_VALID;
 }
 
+int Router::downstreamFreeSlots(int o, int vc) const
+{
+    const TBufferFullStatus & bfs = buffer_full_status_tx[o].read();
+
+    if (credit_flow_control) {
+	int occupancy[MAX_VIRTUAL_CHANNELS];
+
+	for (int v = 0; v < GlobalParams::n_virtual_channels; v++)
+	    occupancy[v] = credits_used[o][v] - bfs.credits[v];
+
+	return downstream_pool[o].freeSlots(occupancy, vc);
+    }
+
+    // Up to date once the previous flit has been acknowledged
+    return bfs.free_slots[vc];
+}
+
+void Router::linkSent(int o)
+{
+    if (serialization[o] > 1)
+	link_free_cycle[o] = (long) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps) + serialization[o];
+}
+
+bool Router::canSend(int o, int vc) const
+{
+    const TBufferFullStatus & bfs = buffer_full_status_tx[o].read();
+
+    if (bfs.gated)
+	return false;
+
+    if (serialization[o] > 1 &&
+	(long) (sc_time_stamp().to_double() / GlobalParams::clock_period_ps) < link_free_cycle[o])
+	return false;
+
+    // The hub keeps the handshake in any case
+    if (credit_flow_control && o != DIRECTION_HUB) {
+	int occupancy[MAX_VIRTUAL_CHANNELS];
+
+	for (int v = 0; v < GlobalParams::n_virtual_channels; v++)
+	    occupancy[v] = credits_used[o][v] - bfs.credits[v];
+
+	return downstream_pool[o].freeSlots(occupancy, vc) > 0;
+    }
+
+    // Alternating bit protocol: the previous flit has been acknowledged
+    return current_level_tx[o] == ack_tx[o].read() && !bfs.mask[vc];
+}
+
+int Router::checkOutput(const RouteData & route_data, int out, TReservation & r)
+{
+    r.out_vc = dynamic_vcs ? NOT_VALID : outputVirtualChannel(route_data, out);
+
+    int rt_status = reservation_table.checkReservation(r, out);
+
+    // VC allocation, once the head is sure to hold no reservation
+    if (rt_status == RT_AVAILABLE && r.out_vc == NOT_VALID)
+    {
+	r.out_vc = allocateVirtualChannel(route_data, out);
+	if (r.out_vc == NOT_VALID)
+	    rt_status = RT_OUTVC_BUSY;
+    }
+
+    return rt_status;
+}
+
+int Router::outputVirtualChannel(const RouteData & route_data, int out) const
+{
+    int first, count;
+    int class_first, class_count;
+
+    outputVirtualChannels(route_data, out, first, count);
+    classVirtualChannels(route_data.traffic_class, class_first, class_count);
+
+    return first + (route_data.vc_id - class_first) % count;
+}
+
+int Router::allocateVirtualChannel(const RouteData & route_data, int out)
+{
+    int in = route_data.dir_in;
+    int vc = route_data.vc_id;
+    int first, count;
+
+    outputVirtualChannels(route_data, out, first, count);
+
+    // Among the VCs not held by other packets, the one with the most
+    // credits downstream. Ties are broken round-robin
+    const TBufferFullStatus & bfs = buffer_full_status_tx[out].read();
+    int best = NOT_VALID;
+
+    for (int k = 0; k < count; k++) {
+	TReservation r;
+	r.input = in;
+	r.vc = vc;
+	r.out_vc = first + (va_ptr[out] + k) % count;
+
+	if (reservation_table.checkReservation(r, out) != RT_AVAILABLE)
+	    continue;
+
+	if (best == NOT_VALID || bfs.free_slots[r.out_vc] > bfs.free_slots[best])
+	    best = r.out_vc;
+    }
+
+    if (best != NOT_VALID)
+	va_ptr[out] = (best - first + 1) % count;
+
+    return best;
+}
+
+void Router::outputVirtualChannels(const RouteData & route_data, int out, int & first, int & count) const
+{
+    int in = route_data.dir_in;
+    int vc = route_data.vc_id;
+
+    first = vc;
+    count = 1;
+
+    // The VC classes below are taken within the VCs of the traffic class
+    int class_first, n_vcs;
+    classVirtualChannels(route_data.traffic_class, class_first, n_vcs);
+
+    if (isLocalPort(out) || out == DIRECTION_HUB || n_vcs < 2)
+	return;
+
+    vc -= class_first;
+
+    // The first VC is the escape channel, taken only along the escape route
+    int escape = routingAlgorithm->escapeDirection(route_data);
+    if (escape != NOT_VALID) {
+	first = class_first + ((out == escape) ? 0 : 1);
+	count = class_first + n_vcs - first;
+	return;
+    }
+
+    // The VCs are split in a lower and an upper class. Packets move to
+    // the upper class when crossing a dateline and stay there while
+    // travelling along the same ring, which breaks its cyclic dependency
+    int half = n_vcs / 2;
+    int vc_class;
+
+    if (!dateline_vcs) {
+	vc_class = routingAlgorithm->outputVcClass(in, vc / half, out);
+	if (vc_class == NOT_VALID) {
+	    first = class_first;
+	    count = n_vcs;
+	    return;
+	}
+    }
+    else if (dateline[out])
+	vc_class = 1;
+    else if (in < DIRECTIONS && out < DIRECTIONS && out == reflexDirection(in))
+	vc_class = vc / half;
+    else
+	vc_class = 0;
+
+    first = class_first + vc_class * half;
+    count = half;
+}
+
 int Router::getNeighborId(int _id, int direction) const
 {
-    assert(GlobalParams::topology == TOPOLOGY_MESH);
-
-    Coord my_coord = id2Coord(_id); 
-
-    switch (direction) {
-    case DIRECTION_NORTH:
-	if (my_coord.y == 0)
-	    return NOT_VALID;
-	my_coord.y--;
-	break;
-    case DIRECTION_SOUTH:
-	if (my_coord.y == GlobalParams::mesh_dim_y - 1)
-	    return NOT_VALID;
-	my_coord.y++;
-	break;
-    case DIRECTION_EAST:
-	if (my_coord.x == GlobalParams::mesh_dim_x - 1)
-	    return NOT_VALID;
-	my_coord.x++;
-	break;
-    case DIRECTION_WEST:
-	if (my_coord.x == 0)
-	    return NOT_VALID;
-	my_coord.x--;
-	break;
-    default:
+    if (direction < 0 || direction >= DIRECTIONS) {
 	LOG << "Direction not valid : " << direction;
 	assert(false);
     }
 
-    int neighbor_id = coord2Id(my_coord);
-
-    return neighbor_id;
+    return TopologyGraph::getInstance()->getNeighbor(_id, direction);
 }
 
 bool Router::inCongestion()
@@ -634,7 +1222,7 @@ bool Router::inCongestion()
 
 void Router::ShowBuffersStats(std::ostream & out)
 {
-  for (int i=0; i<DIRECTIONS+2; i++)
+  for (int i=0; i<n_ports; i++)
       for (int vc=0; vc<GlobalParams::n_virtual_channels;vc++)
 	    buffer[i][vc].ShowStats(out);
 }
@@ -19,39 +19,69 @@
 #include "LocalRoutingTable.h"
 #include "ReservationTable.h"
 #include "Utils.h"
+#include "DVFSController.h"
 #include "routingAlgorithms/RoutingAlgorithm.h"
 #include "routingAlgorithms/RoutingAlgorithms.h"
 #include "selectionStrategies/SelectionStrategy.h"
 #include "selectionStrategies/SelectionStrategy.h"
 #include "selectionStrategies/Selection_NOP.h"
 #include "selectionStrategies/Selection_BUFFER_LEVEL.h"
+#include "switchAllocators/SwitchAllocator.h"
+#include "switchAllocators/SwitchAllocators.h"
 
 using namespace std;
 
 extern unsigned int drained_volume;
 
+// A branch of the tree of a multicast packet: the output it takes, the
+// VC reserved there and the destinations reached through it
+struct MulticastBranch {
+    int output;
+    int out_vc;
+    CoreSet dst_set;
+};
+
+// Power state of a router under power gating
+enum GatingState {
+    GATING_ON,
+    GATING_OFF,		// No leakage, flits are held upstream
+    GATING_WAKING	// Leaking, flits still held upstream
+};
+
 SC_MODULE(Router)
 {
     friend class Selection_NOP;
     friend class Selection_BUFFER_LEVEL;
+    friend class Selection_RCA;
+    friend class Allocator_SEPARABLE_IF;
+    friend class Allocator_SEPARABLE_OF;
+    friend class Allocator_WAVEFRONT;
+    friend class Allocator_CLASS;
+    friend class Allocator_AGE;
+    friend class DeadlockDetector;
 
     // I/O Ports
     sc_in_clk clock;		                  // The input clock for the router
     sc_in <bool> reset;                           // The reset signal for the router
 
-    // number of ports: 4 mesh directions + local + wireless 
-    sc_in <Flit> flit_rx[DIRECTIONS + 2];	  // The input channels 
-    sc_in <bool> req_rx[DIRECTIONS + 2];	  // The requests associated with the input channels
-    sc_out <bool> ack_rx[DIRECTIONS + 2];	  // The outgoing ack signals associated with the input channels
-    sc_out <TBufferFullStatus> buffer_full_status_rx[DIRECTIONS+2];
+    // n_ports ports: 4 mesh directions + local + wireless + additional
+    // network ports + additional locals
+    sc_in <Flit> *flit_rx;	  // The input channels 
+    sc_in <bool> *req_rx;	  // The requests associated with the input channels
+    sc_out <bool> *ack_rx;	  // The outgoing ack signals associated with the input channels
+    sc_out <TBufferFullStatus> *buffer_full_status_rx;
+
+    sc_out <Flit> *flit_tx;   // The output channels
+    sc_out <bool> *req_tx;	  // The requests associated with the output channels
+    sc_in <bool> *ack_tx;	  // The outgoing ack signals associated with the output channels
+    sc_in <TBufferFullStatus> *buffer_full_status_tx;
 
-    sc_out <Flit> flit_tx[DIRECTIONS + 2];   // The output channels
-    sc_out <bool> req_tx[DIRECTIONS + 2];	  // The requests associated with the output channels
-    sc_in <bool> ack_tx[DIRECTIONS + 2];	  // The outgoing ack signals associated with the output channels
-    sc_in <TBufferFullStatus> buffer_full_status_tx[DIRECTIONS+2];
+    sc_out <int> *free_slots;
+    sc_in <int> *free_slots_neighbor;
 
-    sc_out <int> free_slots[DIRECTIONS + 1];
-    sc_in <int> free_slots_neighbor[DIRECTIONS + 1];
+    // Power gating: the sender asks a gated receiver to wake up
+    sc_out <bool> *wake_tx;
+    sc_in <bool> *wake_rx;
 
     // Neighbor-on-Path related I/O
     sc_out < NoP_data > NoP_data_out[DIRECTIONS];
@@ -62,32 +92,101 @@ SC_MODULE(Router)
     int local_id;		                // Unique ID
     int routing_type;		                // Type of routing algorithm
     int selection_type;
-    BufferBank buffer[DIRECTIONS + 2];		// buffer[direction][virtual_channel] 
-    bool current_level_rx[DIRECTIONS + 2];	// Current level for Alternating Bit Protocol (ABP)
-    bool current_level_tx[DIRECTIONS + 2];	// Current level for Alternating Bit Protocol (ABP)
-    Stats stats;		                // Statistics
+    int n_ports;				// Radix of the router
+    int n_local;				// Cores attached to the router
+    BufferBank *buffer;				// buffer[direction][virtual_channel] 
+    bool *current_level_rx;			// Current level for Alternating Bit Protocol (ABP)
+    bool *current_level_tx;			// Current level for Alternating Bit Protocol (ABP)
+    Stats stats[MAX_CONCENTRATION];		// Statistics of the flits received by each core
     Power power;
     LocalRoutingTable routing_table;		// Routing table
     ReservationTable reservation_table;		// Switch reservation table
     unsigned long routed_flits;
+    unsigned long *tx_flits;			// Flits sent on each output port
+    unsigned long sa_matched;			// Switch allocation grants
+    unsigned long sa_max_matching;		// Grants of maximum matchings of the same requests
     RoutingAlgorithm * routingAlgorithm; 
     SelectionStrategy * selectionStrategy; 
+    SwitchAllocator * switchAllocator;
     
     // Functions
 
     void process();
-    void rxProcess();		// The receiving process
-    void txProcess();		// The transmitting process
+    virtual void rxProcess();		// The receiving process
+    virtual void txProcess();		// The transmitting process
     void perCycleUpdate();
     void configure(const int _id, const double _warm_up_time,
 		   const unsigned int _max_buffer_size,
 		   GlobalRoutingTable & grt);
 
+    // Puts the router in its clock domain. Flits coming from other
+    // domains go through a synchronizer
+    void setClockDomain(DVFSController * dvfs);
+
     unsigned long getRoutedFlits();	// Returns the number of routed flits 
+    GatingState getGatingState() const { return gating_state; }
+    unsigned long getTxFlits(const int port) const { return tx_flits[port]; }
+    unsigned long getBufferBits() const;	// Storage of the input buffers
+    const BufferPool & getBufferPool(const int port) const { return buffer_pool[port]; }
+
+    bool isLocalPort(int port) const { return local_index[port] != NOT_VALID; }
+
+    // False if the flits received on the port are not queued, i.e. for
+    // the hub one and the bufferless ports of deflection routers
+    virtual bool hasInputBuffer(int port) const { return port != DIRECTION_HUB; }
+
+    // Flits sent away from their destination (deflection routers)
+    virtual unsigned long getDeflectedFlits() const { return 0; }
+
+    virtual ~Router() {}
 
     // Constructor
 
-    SC_CTOR(Router) {
+    SC_HAS_PROCESS(Router);
+
+    Router(sc_module_name nm, int _n_ports): sc_module(nm) {
+        n_ports = _n_ports;
+        assert(n_ports >= DIRECTION_EXTRA);
+
+        flit_rx = new sc_in<Flit>[n_ports];
+        req_rx = new sc_in<bool>[n_ports];
+        ack_rx = new sc_out<bool>[n_ports];
+        buffer_full_status_rx = new sc_out<TBufferFullStatus>[n_ports];
+
+        flit_tx = new sc_out<Flit>[n_ports];
+        req_tx = new sc_out<bool>[n_ports];
+        ack_tx = new sc_in<bool>[n_ports];
+        buffer_full_status_tx = new sc_in<TBufferFullStatus>[n_ports];
+
+        free_slots = new sc_out<int>[n_ports];
+        free_slots_neighbor = new sc_in<int>[n_ports];
+
+        wake_tx = new sc_out<bool>[n_ports];
+        wake_rx = new sc_in<bool>[n_ports];
+
+        buffer = new BufferBank[n_ports];
+        current_level_rx = new bool[n_ports];
+        current_level_tx = new bool[n_ports];
+        start_from_vc = new int[n_ports];
+        local_index = new int[n_ports];
+        dateline = new bool[n_ports];
+        cdc_delay = new int[n_ports];
+        serialization = new int[n_ports];
+        link_free_cycle = new long[n_ports];
+        tx_flits = new unsigned long[n_ports];
+        sa_input_ptr = new int[n_ports];
+        sa_output_ptr = new int[n_ports];
+        sa_vc_ptr = new int[n_ports];
+        va_ptr = new int[n_ports];
+        buffer_pool = new BufferPool[n_ports];
+        downstream_pool = new BufferPool[n_ports];
+        credits_used = new int*[n_ports];
+        credits_freed = new int*[n_ports];
+        for (int i = 0; i < n_ports; i++) {
+            credits_used[i] = new int[MAX_VIRTUAL_CHANNELS];
+            credits_freed[i] = new int[MAX_VIRTUAL_CHANNELS];
+        }
+
         SC_METHOD(process);
         sensitive << reset;
         sensitive << clock.pos();
@@ -111,9 +210,17 @@ SC_MODULE(Router)
             cerr << " FATAL: invalid selection strategy -sel " << GlobalParams::selection_strategy << ", check with noxim -help" << endl;
             exit(-1);
         }
+
+        switchAllocator = SwitchAllocators::get(GlobalParams::switch_allocator);
+
+        if (switchAllocator == 0)
+        {
+            cerr << " FATAL: invalid switch allocator -sa " << GlobalParams::switch_allocator << ", check with noxim -help" << endl;
+            exit(-1);
+        }
     }
 
-  private:
+  protected:
 
     // performs actual routing + selection
     int route(const RouteData & route_data);
@@ -128,10 +235,111 @@ SC_MODULE(Router)
     int NoPScore(const NoP_data & nop_data, const vector <int> & nop_channels) const;
     int reflexDirection(int direction) const;
     int getNeighborId(int _id, int direction) const;
+
+    // VC to be used on output port out by a packet stored in
+    // input[dir_in][vc_id], according to the dateline VC classes or to
+    // the ones of the routing algorithm, within its traffic class
+    int outputVirtualChannel(const RouteData & route_data, int out) const;
+
+    // Range [first, first + count) of the VCs of port out a packet
+    // stored in input[dir_in][vc_id] may use
+    void outputVirtualChannels(const RouteData & route_data, int out, int & first, int & count) const;
+
+    // Dynamic VC allocation: free VC of the range with the most slots
+    // available downstream, NOT_VALID if all of them are reserved
+    int allocateVirtualChannel(const RouteData & route_data, int out);
+
+    // Reservation status of output out for r, whose out_vc is set to
+    // the VC to be used
+    int checkOutput(const RouteData & route_data, int out, TReservation & r);
+
+    // True if a flit stored in an input buffer has gone through the
+    // router pipeline up to unit (PIPELINE_VA or PIPELINE_ST)
+    bool pipelineDone(const Flit & flit, const int unit) const;
+    bool dateline_vcs;		     // true if the topology has dateline links
+    bool dynamic_vcs;		     // true if output VCs are allocated at each hop
+    bool credit_flow_control;	     // true if ports other than the hub one use credits
+
+    // Credit-based flow control: flits sent on each output VC and flits
+    // removed from each input VC since reset
+    int **credits_used;
+    int **credits_freed;
+
+    // Links narrower than a flit start a new flit on output o once
+    // the previous one has been serialized
+    int *serialization;		     // Cycles taken by a flit on the link of each output
+    long *link_free_cycle;	     // Cycle the link of each output can take a new flit
+    void linkSent(int o);
+
+    // True if the flow control of output o lets a flit go on VC vc,
+    // and its link is free
+    bool canSend(int o, int vc) const;
+
+    // Slots left in VC vc of the input buffer fed by output o
+    int downstreamFreeSlots(int o, int vc) const;
+
+    // Accounts a flit delivered to the core on local port o
+    void drainFlit(int o, const Flit & flit);
+
+    // Power gating. An idle router, i.e. with empty buffers, no
+    // reservations and no flit coming, is gated when the policy finds it
+    // worth it. It wakes up when asked by a sender or when a flit sent
+    // before the sender could see it gated arrives
+    bool power_gating;		     // true if routers are gated when idle
+    GatingState gating_state;
+    int idle_cycles;		     // Cycles of the current idle period, gated ones included
+    double predicted_idle_cycles;    // Average of the past idle periods
+    int wakeup_end_cycle;	     // Cycle the router is on again, while waking up
+    void updatePowerGating();
+    bool gatingPays() const;
+    void updateIdlePrediction();
+    bool isIdle() const;
+    bool wakeupRequested() const;
+    int leakingBuffers() const;	     // Input buffers charged for leakage
+
+    // Clock domains. The input buffers are written at the pace of the
+    // senders, i.e. they are the clock domain crossing FIFOs, while the
+    // rest of the router works at the edges of the domain clock only
+    ClockDomain * clock_domain;	     // NULL with a single clock
+    int *cdc_delay;		     // Synchronizer cycles of the flits received on each port
+    unsigned long local_cycle;	     // Cycles of the domain clock since reset, nominal ones with a single clock
+    bool clockEdge();		     // True if the domain clock has an edge in this cycle
+    bool hasBufferedFlits() const;
+
+    // Branches reserved by the multicast packet in each input VC,
+    // multicast_tree[port][vc], empty for unicast packets
+    vector < vector < vector < MulticastBranch > > > multicast_tree;
+    int active_multicasts;	     // Input VCs holding a multicast tree
+
+    // Splits the destinations of a multicast head received on port in
+    // over the outputs of the routes to each of them, sorted by port
+    vector < MulticastBranch > multicastRoute(const Flit & flit, int in);
+
+    // Reserves the outputs of all the branches of the multicast head in
+    // input[in][vc], or none of them if any is busy
+    void reserveMulticast(const Flit & flit, int in, int vc);
+
+    // Sends the front flit of input[in][vc] on all the branches of its
+    // tree at once
+    void forwardMulticast(int in, int vc);
+
+    BufferPool *buffer_pool;	     // Slots of each input port
+    BufferPool *downstream_pool;     // Slots of the input port fed by each output
+    int *va_ptr;		     // Round-robin pointer of the VC allocator at each output
+    bool *dateline;		     // true if the output link crosses a dateline
    
     vector<int> getNextHops(int src, int dst);
     int start_from_port;	     // Port from which to start the reservation cycle
-    int start_from_vc[DIRECTIONS+2]; // VC from which to start the reservation cycle for the specific port
+    int *start_from_vc; // VC from which to start the reservation cycle for the specific port
+
+    // Round-robin pointers of the switch allocator arbiters
+    int *sa_input_ptr;		// Output with highest priority at each input
+    int *sa_output_ptr;		// Input with highest priority at each output
+    int *sa_vc_ptr;		// VC with highest priority at each input
+    int sa_priority;		// Priority diagonal of the wavefront allocator
+
+    int local_port[MAX_CONCENTRATION];	// Port of each core attached to the router
+    int *local_index;			// Core attached to each port, NOT_VALID for network ones
 
     vector<int> nextDeltaHops(RouteData rd);
   public:
@@ -9,6 +9,7 @@
  */
 
 #include "Stats.h"
+#include "Utils.h"
 
 // TODO: nan in averageDelay
 
@@ -16,6 +17,12 @@ void Stats::configure(const int node_id, const double _warm_up_time)
 {
     id = node_id;
     warm_up_time = _warm_up_time;
+    multicast_deliveries = 0;
+    total_multicast_delay = max_multicast_delay = 0.0;
+    class_packets.assign(trafficClasses(), 0);
+    class_flits.assign(trafficClasses(), 0);
+    class_total_delay.assign(trafficClasses(), 0.0);
+    class_max_delay.assign(trafficClasses(), 0.0);
 }
 
 void Stats::receivedFlit(const double arrival_time,
@@ -33,14 +40,31 @@ void Stats::receivedFlit(const double arrival_time,
 
 	ch.src_id = flit.src_id;
 	ch.total_received_flits = 0;
+	ch.total_network_delay = 0.0;
+	ch.total_hops = 0;
 	chist.push_back(ch);
 
 	i = chist.size() - 1;
     }
 
-    if (flit.flit_type == FLIT_TYPE_HEAD)
+    if (flit.flit_type == FLIT_TYPE_HEAD) {
 	chist[i].delays.push_back(arrival_time - flit.timestamp);
+	chist[i].total_network_delay += arrival_time - flit.injection_timestamp;
+	chist[i].total_hops += flit.hop_no;
+
+	// Each destination of a multicast counts a delivery
+	if (flit.dst_set.any()) {
+	    multicast_deliveries++;
+	    total_multicast_delay += arrival_time - flit.timestamp;
+	    max_multicast_delay = max(max_multicast_delay, arrival_time - flit.timestamp);
+	}
+
+	class_packets[flit.traffic_class]++;
+	class_total_delay[flit.traffic_class] += arrival_time - flit.timestamp;
+	class_max_delay[flit.traffic_class] = max(class_max_delay[flit.traffic_class], arrival_time - flit.timestamp);
+    }
 
+    class_flits[flit.traffic_class]++;
     chist[i].total_received_flits++;
     chist[i].last_received_flit_time = arrival_time - warm_up_time;
 }
@@ -72,6 +96,26 @@ double Stats::getAverageDelay()
     return avg / (double) getReceivedPackets();
 }
 
+double Stats::getAverageNetworkDelay()
+{
+    double sum = 0.0;
+
+    for (unsigned int k = 0; k < chist.size(); k++)
+	sum += chist[k].total_network_delay;
+
+    return sum / (double) getReceivedPackets();
+}
+
+double Stats::getAverageHops()
+{
+    double sum = 0.0;
+
+    for (unsigned int k = 0; k < chist.size(); k++)
+	sum += chist[k].total_hops;
+
+    return sum / (double) getReceivedPackets();
+}
+
 double Stats::getMaxDelay(const int src_id)
 {
     double maxd = -1.0;
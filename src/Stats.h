@@ -21,6 +21,8 @@ using namespace std;
 struct CommHistory {
     int src_id;
      vector < double >delays;
+    double total_network_delay;	// Sum of the delays excluding the source queue
+    unsigned long total_hops;	// Sum of the router-to-router hops of the packets
     unsigned int total_received_flits;
     double last_received_flit_time;
 };
@@ -44,6 +46,14 @@ class Stats {
     // Returns the average delay (cycles) for the current node
     double getAverageDelay();
 
+    // Returns the average delay (cycles) spent in the network only,
+    // i.e. from injection to arrival, for the current node
+    double getAverageNetworkDelay();
+
+    // Returns the average number of router-to-router links crossed by
+    // the packets received by the current node
+    double getAverageHops();
+
     // Returns the max delay for the current node as regards the
     // communication whose source node is src_id
     double getMaxDelay(const int src_id);
@@ -68,6 +78,19 @@ class Stats {
     // current node
     unsigned int getTotalCommunications();
 
+    // Returns the number of multicast packets delivered to the current
+    // node, and the sum and max of their delays (cycles)
+    unsigned int getMulticastDeliveries() const { return multicast_deliveries; }
+    double getTotalMulticastDelay() const { return total_multicast_delay; }
+    double getMaxMulticastDelay() const { return max_multicast_delay; }
+
+    // Returns the packets and flits of traffic class c received by the
+    // current node, and the sum and max of the packet delays (cycles)
+    unsigned long getClassPackets(const int c) const { return class_packets[c]; }
+    unsigned long getClassFlits(const int c) const { return class_flits[c]; }
+    double getClassTotalDelay(const int c) const { return class_total_delay[c]; }
+    double getClassMaxDelay(const int c) const { return class_max_delay[c]; }
+
     // Returns the energy consumed for communication src_id-->dst_id
     // under the following assumptions: (i) Minimal routing is
     // considered, (ii) constant packet size is considered (as the
@@ -84,6 +107,13 @@ class Stats {
     int id;
     vector < CommHistory > chist;
     double warm_up_time;
+    unsigned int multicast_deliveries;
+    double total_multicast_delay;
+    double max_multicast_delay;
+    vector < unsigned long > class_packets;
+    vector < unsigned long > class_flits;
+    vector < double > class_total_delay;
+    vector < double > class_max_delay;
 
     int searchCommHistory(int src_id);
 };
@@ -13,7 +13,10 @@
 
 #include <systemc.h>
 #include "Router.h"
+#include "DeflectionRouter.h"
 #include "ProcessingElement.h"
+#include "MemoryController.h"
+#include "TopologyGraph.h"
 using namespace std;
 
 SC_MODULE(Tile)
@@ -27,16 +30,22 @@ SC_MODULE(Tile)
     sc_in <bool> reset;	                        // The reset signal for the tile
 
     int local_id; // Unique ID
+    int n_ports;  // Radix of the router
 
-    sc_in <Flit> flit_rx[DIRECTIONS];	// The input channels
-    sc_in <bool> req_rx[DIRECTIONS];	        // The requests associated with the input channels
-    sc_out <bool> ack_rx[DIRECTIONS];	        // The outgoing ack signals associated with the input channels
-    sc_out <TBufferFullStatus> buffer_full_status_rx[DIRECTIONS];
+    // Network ports, indexed as the ones of the router. The entries of
+    // the local and hub ports are not connected to the router
+    sc_in <Flit> *flit_rx;	// The input channels
+    sc_in <bool> *req_rx;	        // The requests associated with the input channels
+    sc_out <bool> *ack_rx;	        // The outgoing ack signals associated with the input channels
+    sc_out <TBufferFullStatus> *buffer_full_status_rx;
 
-    sc_out <Flit> flit_tx[DIRECTIONS];	// The output channels
-    sc_out <bool> req_tx[DIRECTIONS];	        // The requests associated with the output channels
-    sc_in <bool> ack_tx[DIRECTIONS];	        // The outgoing ack signals associated with the output channels
-    sc_in <TBufferFullStatus> buffer_full_status_tx[DIRECTIONS];
+    sc_out <Flit> *flit_tx;	// The output channels
+    sc_out <bool> *req_tx;	        // The requests associated with the output channels
+    sc_in <bool> *ack_tx;	        // The outgoing ack signals associated with the output channels
+    sc_in <TBufferFullStatus> *buffer_full_status_tx;
+
+    sc_out <bool> *wake_tx;	// Power gating side-band of the network ports
+    sc_in <bool> *wake_rx;
 
     // hub specific ports
     sc_in <Flit> hub_flit_rx;	// The input channels
@@ -51,40 +60,82 @@ SC_MODULE(Tile)
 
 
     // NoP related I/O and signals
-    sc_out <int> free_slots[DIRECTIONS];
-    sc_in <int> free_slots_neighbor[DIRECTIONS];
+    sc_out <int> *free_slots;
+    sc_in <int> *free_slots_neighbor;
     sc_out < NoP_data > NoP_data_out[DIRECTIONS];
     sc_in < NoP_data > NoP_data_in[DIRECTIONS];
 
     sc_signal <int> free_slots_local;
     sc_signal <int> free_slots_neighbor_local;
 
-    // Signals required for Router-PE connection
-    sc_signal <Flit> flit_rx_local;	
-    sc_signal <bool> req_rx_local;     
-    sc_signal <bool> ack_rx_local;
-    sc_signal <TBufferFullStatus> buffer_full_status_rx_local;
+    // Signals required for Router-PE connection, one set for each local port
+    sc_signal <Flit> flit_rx_local[MAX_CONCENTRATION];
+    sc_signal <bool> req_rx_local[MAX_CONCENTRATION];
+    sc_signal <bool> ack_rx_local[MAX_CONCENTRATION];
+    sc_signal <TBufferFullStatus> buffer_full_status_rx_local[MAX_CONCENTRATION];
+
+    sc_signal <Flit> flit_tx_local[MAX_CONCENTRATION];
+    sc_signal <bool> req_tx_local[MAX_CONCENTRATION];
+    sc_signal <bool> ack_tx_local[MAX_CONCENTRATION];
+    sc_signal <TBufferFullStatus> buffer_full_status_tx_local[MAX_CONCENTRATION];
 
-    sc_signal <Flit> flit_tx_local;
-    sc_signal <bool> req_tx_local;
-    sc_signal <bool> ack_tx_local;
-    sc_signal <TBufferFullStatus> buffer_full_status_tx_local;
+    // PEs are never gated, only their requests to wake up are read
+    sc_signal <bool> wake_rx_local[MAX_CONCENTRATION];
+    sc_signal <bool> wake_tx_local[MAX_CONCENTRATION];
+    sc_signal <bool> hub_wake_rx;
+    sc_signal <bool> hub_wake_tx;
 
 
     // Instances
     Router *r;		                // Router instance
-    ProcessingElement *pe;	                // Processing Element instance
+    int n_pe;					// Number of PEs attached to the router
+    ProcessingElement *pe[MAX_CONCENTRATION];	// Processing Element instances
 
     // Constructor
 
-    Tile(sc_module_name nm, int id): sc_module(nm) {
-    local_id = id;
+    Tile(sc_module_name nm, const TopologyNode & tn): sc_module(nm) {
+    local_id = tn.id;
+    n_ports = tn.radix;
+    n_pe = tn.local_ports.size();
+    assert(n_pe >= 1 && n_pe <= MAX_CONCENTRATION);
+
+	flit_rx = new sc_in<Flit>[n_ports];
+	req_rx = new sc_in<bool>[n_ports];
+	ack_rx = new sc_out<bool>[n_ports];
+	buffer_full_status_rx = new sc_out<TBufferFullStatus>[n_ports];
+
+	flit_tx = new sc_out<Flit>[n_ports];
+	req_tx = new sc_out<bool>[n_ports];
+	ack_tx = new sc_in<bool>[n_ports];
+	buffer_full_status_tx = new sc_in<TBufferFullStatus>[n_ports];
+
+	free_slots = new sc_out<int>[n_ports];
+	free_slots_neighbor = new sc_in<int>[n_ports];
+
+	wake_tx = new sc_out<bool>[n_ports];
+	wake_rx = new sc_in<bool>[n_ports];
 	
     // Router pin assignments
-	r = new Router("Router");
+	if (GlobalParams::router_architecture == ROUTER_DEFLECTION)
+	    r = new DeflectionRouter("Router", tn);
+	else
+	    r = new Router("Router", n_ports);
 	r->clock(clock);
 	r->reset(reset);
-	for (int i = 0; i < DIRECTIONS; i++) {
+	for (int i = 0; i < n_ports; i++) {
+	    // local ports share the PE side-band signals
+	    if (i != DIRECTION_HUB && !TopologyGraph::getInstance()->isNetworkPort(local_id, i)) {
+		r->free_slots[i] (free_slots_local);
+		r->free_slots_neighbor[i] (free_slots_neighbor_local);
+		continue;
+	    }
+
+	    r->free_slots[i] (free_slots[i]);
+	    r->free_slots_neighbor[i] (free_slots_neighbor[i]);
+
+	    if (i == DIRECTION_HUB)
+		continue;
+
 	    r->flit_rx[i] (flit_rx[i]);
 	    r->req_rx[i] (req_rx[i]);
 	    r->ack_rx[i] (ack_rx[i]);
@@ -95,24 +146,33 @@ SC_MODULE(Tile)
 	    r->ack_tx[i] (ack_tx[i]);
 	    r->buffer_full_status_tx[i](buffer_full_status_tx[i]);
 
-	    r->free_slots[i] (free_slots[i]);
-	    r->free_slots_neighbor[i] (free_slots_neighbor[i]);
+	    r->wake_tx[i] (wake_tx[i]);
+	    r->wake_rx[i] (wake_rx[i]);
+	}
 
-	    // NoP 
+	// NoP 
+	for (int i = 0; i < DIRECTIONS; i++) {
 	    r->NoP_data_out[i] (NoP_data_out[i]);
 	    r->NoP_data_in[i] (NoP_data_in[i]);
 	}
 	
 	// local
-	r->flit_rx[DIRECTION_LOCAL] (flit_tx_local);
-	r->req_rx[DIRECTION_LOCAL] (req_tx_local);
-	r->ack_rx[DIRECTION_LOCAL] (ack_tx_local);
-	r->buffer_full_status_rx[DIRECTION_LOCAL] (buffer_full_status_tx_local);
+	for (int k = 0; k < n_pe; k++) {
+	    int port = tn.local_ports[k];
+
+	    r->flit_rx[port] (flit_tx_local[k]);
+	    r->req_rx[port] (req_tx_local[k]);
+	    r->ack_rx[port] (ack_tx_local[k]);
+	    r->buffer_full_status_rx[port] (buffer_full_status_tx_local[k]);
 
-	r->flit_tx[DIRECTION_LOCAL] (flit_rx_local);
-	r->req_tx[DIRECTION_LOCAL] (req_rx_local);
-	r->ack_tx[DIRECTION_LOCAL] (ack_rx_local);
-	r->buffer_full_status_tx[DIRECTION_LOCAL] (buffer_full_status_rx_local);
+	    r->flit_tx[port] (flit_rx_local[k]);
+	    r->req_tx[port] (req_rx_local[k]);
+	    r->ack_tx[port] (ack_rx_local[k]);
+	    r->buffer_full_status_tx[port] (buffer_full_status_rx_local[k]);
+
+	    r->wake_tx[port] (wake_rx_local[k]);
+	    r->wake_rx[port] (wake_tx_local[k]);
+	}
 
 
 	// hub related
@@ -125,29 +185,42 @@ SC_MODULE(Tile)
 	r->req_tx[DIRECTION_HUB] (hub_req_tx);
 	r->ack_tx[DIRECTION_HUB] (hub_ack_tx);
 	r->buffer_full_status_tx[DIRECTION_HUB] (hub_buffer_full_status_tx);
+	r->wake_tx[DIRECTION_HUB] (hub_wake_tx);
+	r->wake_rx[DIRECTION_HUB] (hub_wake_rx);
 
 
 	// Processing Element pin assignments
-	pe = new ProcessingElement("ProcessingElement");
-	pe->clock(clock);
-	pe->reset(reset);
-
-	pe->flit_rx(flit_rx_local);
-	pe->req_rx(req_rx_local);
-	pe->ack_rx(ack_rx_local);
-	pe->buffer_full_status_rx(buffer_full_status_rx_local);
-	
-
-	pe->flit_tx(flit_tx_local);
-	pe->req_tx(req_tx_local);
-	pe->ack_tx(ack_tx_local);
-	pe->buffer_full_status_tx(buffer_full_status_tx_local);
-
-	// NoP
-	//
-	r->free_slots[DIRECTION_LOCAL] (free_slots_local);
-	r->free_slots_neighbor[DIRECTION_LOCAL] (free_slots_neighbor_local);
-	pe->free_slots_neighbor(free_slots_neighbor_local);
+	for (int k = 0; k < MAX_CONCENTRATION; k++)
+	    pe[k] = NULL;
+
+	for (int k = 0; k < n_pe; k++) {
+	    string pe_name = "ProcessingElement";
+	    if (k > 0)
+		pe_name += i_to_string(k);
+
+	    if (k < (int) tn.cores.size() && isMemoryController(tn.cores[k]))
+		pe[k] = new MemoryController(pe_name.c_str());
+	    else
+		pe[k] = new ProcessingElement(pe_name.c_str());
+	    pe[k]->clock(clock);
+	    pe[k]->reset(reset);
+	    pe[k]->router_pool.configure(tn.damq);
+	    if (GlobalParams::router_architecture == ROUTER_DEFLECTION)
+		pe[k]->reassembly_stats = &r->stats[k];
+
+	    pe[k]->flit_rx(flit_rx_local[k]);
+	    pe[k]->req_rx(req_rx_local[k]);
+	    pe[k]->ack_rx(ack_rx_local[k]);
+	    pe[k]->buffer_full_status_rx(buffer_full_status_rx_local[k]);
+
+	    pe[k]->flit_tx(flit_tx_local[k]);
+	    pe[k]->req_tx(req_tx_local[k]);
+	    pe[k]->ack_tx(ack_tx_local[k]);
+	    pe[k]->buffer_full_status_tx(buffer_full_status_tx_local[k]);
+	    pe[k]->wake_tx(wake_tx_local[k]);
+
+	    pe[k]->free_slots_neighbor(free_slots_neighbor_local);
+	}
 
     }
 
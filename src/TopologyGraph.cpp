@@ -0,0 +1,366 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the topology graph
+ */
+
+#include <cmath>
+#include "TopologyGraph.h"
+
+TopologyGraph * TopologyGraph::topologyGraph = 0;
+
+TopologyGraph * TopologyGraph::getInstance()
+{
+    if (topologyGraph == 0)
+	topologyGraph = new TopologyGraph();
+
+    return topologyGraph;
+}
+
+TopologyGraph::TopologyGraph()
+{
+    core_count = 0;
+    dateline_count = 0;
+    boundary_count = 0;
+}
+
+void TopologyGraph::clear()
+{
+    nodes.clear();
+    links.clear();
+    node_index.clear();
+    core_node.clear();
+    core_index.clear();
+    coord_index.clear();
+    core_count = 0;
+    dateline_count = 0;
+    boundary_count = 0;
+}
+
+void TopologyGraph::addNode(const int id, const Coord & coord, const bool switch_only, const string & name)
+{
+    if (id < 0) {
+	cerr << "Error: invalid node id " << id << endl;
+	exit(1);
+    }
+
+    if (id >= (int) node_index.size())
+	node_index.resize(id + 1, NOT_VALID);
+
+    if (node_index[id] != NOT_VALID) {
+	cerr << "Error: node " << id << " defined twice" << endl;
+	exit(1);
+    }
+
+    TopologyNode n;
+    n.id = id;
+    n.coord = coord;
+    n.switch_only = switch_only;
+    n.name = name;
+    n.radix = 0;
+    n.damq = (GlobalParams::buffer_organization == BUFFER_ORGANIZATION_DAMQ);
+    n.out_link.assign(DIRECTIONS, NOT_VALID);
+    n.in_link.assign(DIRECTIONS, NOT_VALID);
+
+    node_index[id] = nodes.size();
+    nodes.push_back(n);
+}
+
+void TopologyGraph::addCore(const int core_id, const int node_id)
+{
+    TopologyNode & n = node(node_id);
+
+    if (n.switch_only) {
+	cerr << "Error: core " << core_id << " attached to switch-only node " << node_id << endl;
+	exit(1);
+    }
+
+    if (n.cores.size() >= MAX_CONCENTRATION) {
+	cerr << "Error: node " << node_id << " has more than " << MAX_CONCENTRATION << " cores" << endl;
+	exit(1);
+    }
+
+    if (core_id < 0) {
+	cerr << "Error: invalid core id " << core_id << endl;
+	exit(1);
+    }
+
+    if (core_id >= (int) core_node.size()) {
+	core_node.resize(core_id + 1, NOT_VALID);
+	core_index.resize(core_id + 1, NOT_VALID);
+    }
+
+    if (core_node[core_id] != NOT_VALID) {
+	cerr << "Error: core " << core_id << " defined twice" << endl;
+	exit(1);
+    }
+
+    core_node[core_id] = node_id;
+    core_index[core_id] = n.cores.size();
+    n.cores.push_back(core_id);
+}
+
+TopologyNode & TopologyGraph::node(const int id)
+{
+    if (id < 0 || id >= (int) node_index.size() || node_index[id] == NOT_VALID) {
+	cerr << "Error: node " << id << " does not exist" << endl;
+	exit(1);
+    }
+
+    return nodes[node_index[id]];
+}
+
+const TopologyNode & TopologyGraph::getNode(const int id) const
+{
+    assert(id >= 0 && id < (int) node_index.size() && node_index[id] != NOT_VALID);
+
+    return nodes[node_index[id]];
+}
+
+void TopologyGraph::addLink(const int src_id, const int src_port, const int dst_id, const int dst_port, const double length,
+			    const bool dateline, int latency, const int width, const bool boundary)
+{
+    if (latency == 0)
+	latency = GlobalParams::r2r_link_latency;
+    if (GlobalParams::link_mm_per_cycle > 0)
+	latency = max(latency, (int) ceil(length / GlobalParams::link_mm_per_cycle));
+
+    if (latency < 1) {
+	cerr << "Error: link " << src_id << "." << src_port << " -> " << dst_id << "." << dst_port
+	     << " must have a latency of at least one cycle" << endl;
+	exit(1);
+    }
+
+    if (width < 0 || width > GlobalParams::flit_size) {
+	cerr << "Error: link " << src_id << "." << src_port << " -> " << dst_id << "." << dst_port
+	     << " must be at most " << GlobalParams::flit_size << " bits wide" << endl;
+	exit(1);
+    }
+
+    if (src_port < 0 || src_port == DIRECTION_LOCAL || src_port == DIRECTION_HUB ||
+	dst_port < 0 || dst_port == DIRECTION_LOCAL || dst_port == DIRECTION_HUB) {
+	cerr << "Error: link " << src_id << "." << src_port << " -> " << dst_id << "." << dst_port
+	     << " uses an invalid port" << endl;
+	exit(1);
+    }
+
+    TopologyNode & src = node(src_id);
+    TopologyNode & dst = node(dst_id);
+
+    if (src_port >= (int) src.out_link.size()) {
+	src.out_link.resize(src_port + 1, NOT_VALID);
+	src.in_link.resize(src_port + 1, NOT_VALID);
+    }
+
+    if (dst_port >= (int) dst.in_link.size()) {
+	dst.out_link.resize(dst_port + 1, NOT_VALID);
+	dst.in_link.resize(dst_port + 1, NOT_VALID);
+    }
+
+    if (src.out_link[src_port] != NOT_VALID) {
+	cerr << "Error: output port " << src_port << " of node " << src_id << " connected twice" << endl;
+	exit(1);
+    }
+
+    if (dst.in_link[dst_port] != NOT_VALID) {
+	cerr << "Error: input port " << dst_port << " of node " << dst_id << " connected twice" << endl;
+	exit(1);
+    }
+
+    TopologyLink l;
+    l.src_id = src_id;
+    l.src_port = src_port;
+    l.dst_id = dst_id;
+    l.dst_port = dst_port;
+    l.length = length;
+    l.dateline = dateline;
+    l.latency = latency;
+    l.width = (width == 0) ? GlobalParams::flit_size : width;
+    l.boundary = boundary;
+
+    if (dateline)
+	dateline_count++;
+    if (boundary)
+	boundary_count++;
+
+    src.out_link[src_port] = links.size();
+    dst.in_link[dst_port] = links.size();
+    links.push_back(l);
+}
+
+void TopologyGraph::addChannel(const int a_id, const int a_port, const int b_id, const int b_port, const double length,
+			       const bool dateline, const int latency, const int width, const bool boundary)
+{
+    addLink(a_id, a_port, b_id, b_port, length, dateline, latency, width, boundary);
+    addLink(b_id, b_port, a_id, a_port, length, dateline, latency, width, boundary);
+}
+
+void TopologyGraph::finalize()
+{
+    core_count = 0;
+    coord_index.clear();
+
+    for (unsigned int i = 0; i < node_index.size(); i++)
+	if (node_index[i] == NOT_VALID) {
+	    cerr << "Error: node ids must be contiguous, node " << i << " is missing" << endl;
+	    exit(1);
+	}
+
+    for (unsigned int i = 0; i < nodes.size(); i++)
+	if (nodes[i].coord.x != NOT_VALID && nodes[i].coord.y != NOT_VALID)
+	    coord_index[make_pair(make_pair(nodes[i].coord.x, nodes[i].coord.y), nodes[i].coord.z)] = nodes[i].id;
+
+    if (core_node.empty())
+    {
+	// One core per node, with the id of the node
+	for (unsigned int i = 0; i < nodes.size(); i++)
+	    if (!nodes[i].switch_only)
+		core_count++;
+
+	// Cores come first, so that PE ids range in [0, core_count)
+	for (int id = 0; id < core_count; id++)
+	    if (getNode(id).switch_only) {
+		cerr << "Error: nodes with a PE must have ids lower than switch-only nodes" << endl;
+		exit(1);
+	    }
+
+	for (int id = 0; id < core_count; id++)
+	    addCore(id, id);
+    }
+
+    core_count = core_node.size();
+
+    for (int c = 0; c < core_count; c++)
+	if (core_node[c] == NOT_VALID) {
+	    cerr << "Error: core ids must be contiguous, core " << c << " is missing" << endl;
+	    exit(1);
+	}
+
+    // Router ports: the network ones, local and hub included, then an
+    // additional local port for each core after the first one
+    for (unsigned int i = 0; i < nodes.size(); i++) {
+	TopologyNode & n = nodes[i];
+
+	n.radix = max((int) n.out_link.size(), DIRECTION_EXTRA);
+	n.local_ports.clear();
+	n.local_ports.push_back(DIRECTION_LOCAL);
+	for (unsigned int k = 1; k < n.cores.size(); k++)
+	    n.local_ports.push_back(n.radix++);
+
+	n.out_link.resize(n.radix, NOT_VALID);
+	n.in_link.resize(n.radix, NOT_VALID);
+    }
+}
+
+int TopologyGraph::getNeighbor(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).out_link[port];
+
+    return (l == NOT_VALID) ? NOT_VALID : links[l].dst_id;
+}
+
+int TopologyGraph::getInputNeighbor(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).in_link[port];
+
+    return (l == NOT_VALID) ? NOT_VALID : links[l].src_id;
+}
+
+bool TopologyGraph::hasInput(const int id, const int port) const
+{
+    const TopologyNode & n = getNode(id);
+
+    return port < (int) n.in_link.size() && n.in_link[port] != NOT_VALID;
+}
+
+bool TopologyGraph::hasOutput(const int id, const int port) const
+{
+    const TopologyNode & n = getNode(id);
+
+    return port < (int) n.out_link.size() && n.out_link[port] != NOT_VALID;
+}
+
+int TopologyGraph::getPort(const int src_id, const int dst_id) const
+{
+    const TopologyNode & n = getNode(src_id);
+
+    for (unsigned int p = 0; p < n.out_link.size(); p++)
+	if (n.out_link[p] != NOT_VALID && links[n.out_link[p]].dst_id == dst_id)
+	    return p;
+
+    return NOT_VALID;
+}
+
+double TopologyGraph::getLinkLength(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).out_link[port];
+
+    return (l == NOT_VALID) ? NOT_VALID : links[l].length;
+}
+
+bool TopologyGraph::isDateline(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).out_link[port];
+
+    return (l != NOT_VALID) && links[l].dateline;
+}
+
+int TopologyGraph::getLinkLatency(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).out_link[port];
+
+    return (l == NOT_VALID) ? 0 : links[l].latency;
+}
+
+int TopologyGraph::getLinkSerialization(const int id, const int port) const
+{
+    assert(port >= 0 && port < getNode(id).radix);
+
+    int l = getNode(id).out_link[port];
+
+    if (l == NOT_VALID)
+	return 1;
+
+    return (GlobalParams::flit_size + links[l].width - 1) / links[l].width;
+}
+
+bool TopologyGraph::isNetworkPort(const int id, const int port) const
+{
+    const TopologyNode & n = getNode(id);
+
+    if (port == DIRECTION_HUB)
+	return false;
+
+    for (unsigned int k = 0; k < n.local_ports.size(); k++)
+	if (n.local_ports[k] == port)
+	    return false;
+
+    return true;
+}
+
+Coord TopologyGraph::getCoord(const int id) const
+{
+    return getNode(id).coord;
+}
+
+int TopologyGraph::getId(const Coord & coord) const
+{
+    map < pair < pair < int, int >, int >, int >::const_iterator it =
+	coord_index.find(make_pair(make_pair(coord.x, coord.y), coord.z));
+
+    return (it == coord_index.end()) ? NOT_VALID : it->second;
+}
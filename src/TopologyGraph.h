@@ -0,0 +1,155 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the topology graph, i.e. the
+ * description of nodes and links used to elaborate the network
+ */
+
+#ifndef __NOXIMTOPOLOGYGRAPH_H__
+#define __NOXIMTOPOLOGYGRAPH_H__
+
+#include <map>
+#include <string>
+#include <vector>
+#include "DataStructs.h"
+
+using namespace std;
+
+// TopologyNode -- a router of the network, with or without PEs attached
+struct TopologyNode {
+    int id;
+    Coord coord;		// NOT_VALID coordinates if meaningless
+    bool switch_only;		// true if no traffic is generated/consumed
+    string name;		// Name of the corresponding Tile
+    vector < int > cores;	// Ids of the cores attached, in local port order
+    vector < int > local_ports;	// Router port of each core (DIRECTION_LOCAL first)
+    int radix;			// Number of router ports, set by finalize()
+    bool damq;			// Input ports use DAMQ buffers (buffer_organization by default)
+    vector < int > out_link;	// Link index for each output port (NOT_VALID if none)
+    vector < int > in_link;	// Link index for each input port (NOT_VALID if none)
+};
+
+// TopologyLink -- unidirectional link from an output to an input port
+struct TopologyLink {
+    int src_id;
+    int src_port;
+    int dst_id;
+    int dst_port;
+    double length;		// Wire length (mm)
+    bool dateline;		// Crossing it moves packets to the upper VC class
+    int latency;		// Cycles needed to traverse it
+    int width;			// Bits transferred per cycle
+    bool boundary;		// Crosses a chiplet boundary (interposer link)
+};
+
+class TopologyGraph {
+
+  public:
+
+    static TopologyGraph * getInstance();
+
+    // Removes all the nodes and links
+    void clear();
+
+    // Adds a node. Nodes are elaborated in the order they are added
+    void addNode(const int id, const Coord & coord, const bool switch_only, const string & name);
+
+    // Adds a unidirectional link src_id.src_port -> dst_id.dst_port.
+    // Ports beyond the mesh directions start from DIRECTION_EXTRA. A
+    // width of 0 stands for flit_size, narrower links serialize flits.
+    // A latency of 0 stands for r2r_link_latency, and links are never
+    // faster than their length allows with link_mm_per_cycle
+    void addLink(const int src_id, const int src_port, const int dst_id, const int dst_port, const double length,
+		 const bool dateline = false, int latency = 0, const int width = 0,
+		 const bool boundary = false);
+
+    // Attaches a core (i.e. a PE) to a node. If no core is added, each
+    // node which is not switch_only gets a core with the same id
+    void addCore(const int core_id, const int node_id);
+
+    // Selects DAMQ or statically partitioned input buffers for a node
+    void setDamq(const int id, const bool damq) { node(id).damq = damq; }
+
+    // Adds a pair of links a.a_port <-> b.b_port
+    void addChannel(const int a_id, const int a_port, const int b_id, const int b_port, const double length,
+		    const bool dateline = false, const int latency = 0, const int width = 0,
+		    const bool boundary = false);
+
+    // Checks the graph, assigns the local ports and builds the lookup tables
+    void finalize();
+
+    int size() const { return nodes.size(); }
+    int getCoreCount() const { return core_count; }
+
+    const vector < TopologyNode > & getNodes() const { return nodes; }
+    const vector < TopologyLink > & getLinks() const { return links; }
+    const TopologyNode & getNode(const int id) const;
+
+    // Node a core is attached to, and index of the core among the
+    // ones of that node
+    int getCoreNode(const int core_id) const { return core_node[core_id]; }
+    int getCoreIndex(const int core_id) const { return core_index[core_id]; }
+
+    // Number of ports of the router of a node, local and hub ones included
+    int getRadix(const int id) const { return getNode(id).radix; }
+
+    // True if the port may be connected to a link, i.e. it is neither a
+    // local port nor the hub one
+    bool isNetworkPort(const int id, const int port) const;
+
+    // Returns the node reached from output port, NOT_VALID if none
+    int getNeighbor(const int id, const int port) const;
+
+    // Returns the node feeding the input port, NOT_VALID if none
+    int getInputNeighbor(const int id, const int port) const;
+
+    bool hasInput(const int id, const int port) const;
+    bool hasOutput(const int id, const int port) const;
+
+    // Returns the output port of src_id connected to dst_id, NOT_VALID if none
+    int getPort(const int src_id, const int dst_id) const;
+
+    // Returns the length of the link leaving the output port, NOT_VALID if none
+    double getLinkLength(const int id, const int port) const;
+
+    // True if the link leaving the output port crosses a dateline
+    bool isDateline(const int id, const int port) const;
+
+    // Returns the latency (cycles) of the link leaving the output port
+    int getLinkLatency(const int id, const int port) const;
+
+    // Returns the cycles a flit takes to be serialized on the link
+    // leaving the output port, 1 if the link is as wide as a flit
+    int getLinkSerialization(const int id, const int port) const;
+    bool hasDatelines() const { return dateline_count > 0; }
+    bool hasBoundaryLinks() const { return boundary_count > 0; }
+
+    Coord getCoord(const int id) const;
+
+    // Returns the node with the given coordinates, NOT_VALID if none
+    int getId(const Coord & coord) const;
+
+  private:
+
+    TopologyGraph();
+
+    static TopologyGraph * topologyGraph;
+
+    vector < TopologyNode > nodes;		// In insertion order
+    vector < TopologyLink > links;
+    vector < int > node_index;			// id -> position in nodes
+    vector < int > core_node;			// core id -> node id
+    vector < int > core_index;			// core id -> index in node cores
+    map < pair < pair < int, int >, int >, int > coord_index;	// ((x,y),z) -> id
+    int core_count;
+    int dateline_count;
+    int boundary_count;
+
+    TopologyNode & node(const int id);
+};
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the implementation of the binary packet traces
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sstream>
+#include "TrafficTrace.h"
+
+TrafficTrace::TrafficTrace()
+{
+    base = NULL;
+    length = 0;
+    header = NULL;
+    first = NULL;
+    records = NULL;
+}
+
+TrafficTrace::~TrafficTrace()
+{
+    if (base != NULL)
+	munmap(base, length);
+}
+
+bool TrafficTrace::load(const char *fname, const int cores, string & error)
+{
+    int fd = open(fname, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) < 0) {
+	error = string("can not open trace ") + fname;
+	if (fd >= 0)
+	    close(fd);
+	return false;
+    }
+
+    length = st.st_size;
+    if (length < sizeof(TraceHeader)) {
+	close(fd);
+	error = string(fname) + " is not a trace";
+	return false;
+    }
+
+    // The mapping stays valid once the file is closed
+    base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+	base = NULL;
+	error = string("can not map trace ") + fname;
+	return false;
+    }
+
+    header = (const TraceHeader *) base;
+    first = (const uint64_t *) (header + 1);
+    records = (const TraceRecord *) (first + header->cores + 1);
+
+    ostringstream msg;
+
+    if (memcmp(header->magic, TRACE_MAGIC, 4) != 0 || header->version != TRACE_VERSION)
+	msg << fname << " is not a version " << TRACE_VERSION << " trace";
+    else if ((int) header->cores > cores)
+	msg << "trace " << fname << " has " << header->cores << " cores, the network " << cores;
+    else if (header->packets >= TRACE_NO_DEPENDENCY ||
+	     length != (size_t) ((const char *) (records + header->packets) - (const char *) base))
+	msg << "trace " << fname << " is truncated or corrupted";
+    else {
+	for (uint32_t c = 0; c < header->cores; c++)
+	    if (first[c] > first[c + 1] || first[c + 1] > header->packets)
+		msg << "bad packet index of core " << c << " in trace " << fname;
+    }
+
+    if (!msg.str().empty()) {
+	error = msg.str();
+	return false;
+    }
+
+    delivered.assign(header->packets, false);
+
+    return true;
+}
+
+TraceCursor TrafficTrace::getCursor(const int core) const
+{
+    TraceCursor cursor;
+
+    if (header == NULL || core >= (int) header->cores)
+	return cursor;
+
+    cursor.next = records + first[core];
+    cursor.end = records + first[core + 1];
+    cursor.id = first[core];
+
+    return cursor;
+}
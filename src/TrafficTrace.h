@@ -0,0 +1,89 @@
+/*
+ * Noxim - the NoC Simulator
+ *
+ * (C) 2005-2018 by the University of Catania
+ * For the complete list of authors refer to file ../doc/AUTHORS.txt
+ * For the license applied to these sources refer to file ../doc/LICENSE.txt
+ *
+ * This file contains the declaration of the binary packet traces
+ */
+
+#ifndef __NOXIMTRAFFICTRACE_H__
+#define __NOXIMTRAFFICTRACE_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define TRACE_MAGIC		"NXTR"
+#define TRACE_VERSION		1
+#define TRACE_NO_DEPENDENCY	0xFFFFFFFF
+
+// Layout of a trace file, in the byte order of the host:
+//   TraceHeader
+//   uint64_t first[cores + 1]	index of the first packet of each source core
+//   TraceRecord packets[packets]	grouped by source, by cycle in each group
+// Packets are identified by their index in the file
+struct TraceHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t cores;
+    uint32_t reserved;
+    uint64_t packets;
+};
+
+struct TraceRecord {
+    uint64_t cycle;		// Generation cycle, counted from the end of the reset
+    uint32_t dependency;	// Packet to be received before this one is sent
+    uint16_t dst;		// Destination core
+    uint8_t size;		// Flits, single flit packets are sent as two
+    uint8_t traffic_class;
+};
+
+// TraceCursor -- the packets of a source core still to be sent
+struct TraceCursor {
+    const TraceRecord *next;
+    const TraceRecord *end;
+    uint32_t id;		// Index of next in the file
+
+    TraceCursor() { next = end = NULL; id = 0; }
+
+    bool done() const { return next == end; }
+    unsigned long left() const { return end - next; }
+};
+
+// TrafficTrace -- a packet trace mapped in memory. Sources read their
+// packets through cursors, pages being loaded by the OS as they go
+class TrafficTrace {
+
+  public:
+
+    TrafficTrace();
+    ~TrafficTrace();
+
+    // Maps the trace file. Returns false, with an error message, if it
+    // can not be used
+    bool load(const char *fname, const int cores, string & error);
+
+    TraceCursor getCursor(const int core) const;
+    const TraceRecord & getRecord(const uint32_t id) const { return records[id]; }
+
+    // Packets received by their destination, for the dependencies
+    void setDelivered(const uint32_t id) { delivered[id] = true; }
+    bool isDelivered(const uint32_t id) const { return delivered[id]; }
+
+    uint64_t getPacketCount() const { return header ? header->packets : 0; }
+
+  private:
+
+    void *base;
+    size_t length;
+    const TraceHeader *header;
+    const uint64_t *first;
+    const TraceRecord *records;
+    vector < bool > delivered;
+};
+
+#endif
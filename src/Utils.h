@@ -15,6 +15,8 @@
 #include <tlm>
 
 #include "DataStructs.h"
+#include "TopologyGraph.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -94,7 +96,12 @@ inline ostream & operator <<(ostream & os, const Flit & flit)
 	    break;
 	}
 
-	os <<  flit.sequence_no << ", " << flit.src_id << "->" << flit.dst_id << " VC " << flit.vc_id << ")";
+	os <<  flit.sequence_no << ", " << flit.src_id << "->";
+	if (flit.dst_id == NOT_VALID)
+	    os << "{" << flit.dst_set.count() << " cores}";
+	else
+	    os << flit.dst_id;
+	os << " VC " << flit.vc_id << ")";
     }
 
     return os;
@@ -134,7 +141,10 @@ inline ostream & operator <<(ostream & os, const TBufferFullStatus & bfs)
 
 inline ostream & operator <<(ostream & os, const Coord & coord)
 {
-    os << "(" << coord.x << "," << coord.y << ")";
+    if (GlobalParams::mesh_dim_z > 1)
+	os << "(" << coord.x << "," << coord.y << "," << coord.z << ")";
+    else
+	os << "(" << coord.x << "," << coord.y << ")";
 
     return os;
 }
@@ -168,25 +178,106 @@ inline void sc_trace(sc_trace_file * &tf, const ChannelStatus & bs, string & nam
 
 // Misc common functions
 
+// Lowest core of a multicast destination set, NOT_VALID if empty
+inline int firstCore(const CoreSet & cores)
+{
+    for (int c = 0; c < MAX_MULTICAST_CORES; c++)
+	if (cores.test(c))
+	    return c;
+
+    return NOT_VALID;
+}
+
+// True if the PE of core is replaced by a memory controller
+inline bool isMemoryController(const int core)
+{
+    return find(GlobalParams::memory_controller_cores.begin(), GlobalParams::memory_controller_cores.end(),
+		core) != GlobalParams::memory_controller_cores.end();
+}
+
+// Number of traffic classes, at least one
+inline int trafficClasses()
+{
+    return max((int) GlobalParams::class_vcs.size(), 1);
+}
+
+// VCs [first, first + count) of a traffic class, all of them if the
+// VCs are not split among classes
+inline void classVirtualChannels(const int traffic_class, int & first, int & count)
+{
+    first = 0;
+    count = GlobalParams::n_virtual_channels;
+
+    if (GlobalParams::class_vcs.empty())
+	return;
+
+    for (int c = 0; c < traffic_class; c++)
+	first += GlobalParams::class_vcs[c];
+    count = GlobalParams::class_vcs[traffic_class];
+}
+
+// True if the tiles lie on a mesh_dim_x * mesh_dim_y (* mesh_dim_z) grid
+inline bool isMeshTopology()
+{
+    return GlobalParams::topology == TOPOLOGY_MESH ||
+	GlobalParams::topology == TOPOLOGY_TORUS ||
+	GlobalParams::topology == TOPOLOGY_FOLDED_TORUS ||
+	GlobalParams::topology == TOPOLOGY_CMESH ||
+	GlobalParams::topology == TOPOLOGY_MESH3D ||
+	GlobalParams::topology == TOPOLOGY_CHIPLET;
+}
+
+// Delta networks have n_delta_tiles = delta_radix^stages cores and
+// stages of n_delta_tiles/delta_radix switches
+inline int deltaStages()
+{
+    int stages = 0;
+
+    for (int n = 1; n < GlobalParams::n_delta_tiles; n *= GlobalParams::delta_radix)
+	stages++;
+
+    return stages;
+}
+
+inline int deltaSwitches()
+{
+    return GlobalParams::n_delta_tiles / GlobalParams::delta_radix;
+}
+
+// Switch ports driving the d-th output line and fed by the d-th input
+// line. Radix-2 switches use the outputs 0, 1 and the inputs 3, 2
+inline int deltaOutputPort(const int d)
+{
+    return (d < DIRECTION_LOCAL) ? d : DIRECTION_EXTRA + d - DIRECTION_LOCAL;
+}
+
+inline int deltaInputPort(const int d)
+{
+    return (d < DIRECTION_LOCAL) ? DIRECTION_LOCAL - 1 - d : DIRECTION_EXTRA + d - DIRECTION_LOCAL;
+}
+
 inline Coord id2Coord(int id)
 {
     Coord coord;
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (isMeshTopology())
     {
         coord.x = id % GlobalParams::mesh_dim_x;
-        coord.y = id / GlobalParams::mesh_dim_x;
+        coord.y = (id / GlobalParams::mesh_dim_x) % GlobalParams::mesh_dim_y;
+        coord.z = id / (GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y);
 
         assert(coord.x < GlobalParams::mesh_dim_x);
-        assert(coord.y < GlobalParams::mesh_dim_y);
+        assert(coord.z < GlobalParams::mesh_dim_z);
     }
+    else if (GlobalParams::topology == TOPOLOGY_CUSTOM)
+        coord = TopologyGraph::getInstance()->getCoord(id);
     else // other delta topologies
     {
         id = id - GlobalParams::n_delta_tiles;
-        coord.x = id / (int)(GlobalParams::n_delta_tiles/2);
-        coord.y = id % (int)(GlobalParams::n_delta_tiles/2);
+        coord.x = id / deltaSwitches();
+        coord.y = id % deltaSwitches();
 
-        assert(coord.x < log2(GlobalParams::n_delta_tiles));
-        assert(coord.y < (GlobalParams::n_delta_tiles/2));
+        assert(coord.x < deltaStages());
+        assert(coord.y < deltaSwitches());
 
     }
     return coord;
@@ -195,20 +286,86 @@ inline Coord id2Coord(int id)
 inline int coord2Id(const Coord & coord)
 {
     int id;
-    if (GlobalParams::topology == TOPOLOGY_MESH)
+    if (isMeshTopology())
+    {
+        id = ((coord.z * GlobalParams::mesh_dim_y + coord.y) * GlobalParams::mesh_dim_x) + coord.x;
+        assert(id < GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y * GlobalParams::mesh_dim_z);
+    }
+    else if (GlobalParams::topology == TOPOLOGY_CUSTOM)
     {
-        id = (coord.y * GlobalParams::mesh_dim_x) + coord.x;
-        assert(id < GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y);
+        id = TopologyGraph::getInstance()->getId(coord);
+        assert(id != NOT_VALID);
     }
     else
     {   //use only for switch bloc in delta topologies
-        id = (coord.x * (GlobalParams::n_delta_tiles/2)) + coord.y + GlobalParams::n_delta_tiles;
+        id = (coord.x * deltaSwitches()) + coord.y + GlobalParams::n_delta_tiles;
         assert(id > (GlobalParams::n_delta_tiles-1));
     }
 
     return id;
 }
 
+// In mesh topologies the cores lie on a grid too: each router hosts a
+// concentration_x * concentration_y block of cores, and core ids are
+// numbered router by router. The layers of 3D meshes are stacked along y
+inline int concentrationX()
+{
+    return (GlobalParams::concentration == 4) ? 2 : GlobalParams::concentration;
+}
+
+inline int concentrationY()
+{
+    return GlobalParams::concentration / concentrationX();
+}
+
+inline int coreDimX()
+{
+    return GlobalParams::mesh_dim_x * concentrationX();
+}
+
+inline int coreDimY()
+{
+    return GlobalParams::mesh_dim_y * GlobalParams::mesh_dim_z * concentrationY();
+}
+
+inline Coord coreId2Coord(int core_id)
+{
+    Coord router = id2Coord(core_id / GlobalParams::concentration);
+    int k = core_id % GlobalParams::concentration;
+    Coord coord;
+
+    coord.x = router.x * concentrationX() + k % concentrationX();
+    coord.y = (router.z * GlobalParams::mesh_dim_y + router.y) * concentrationY() + k / concentrationX();
+
+    return coord;
+}
+
+inline int coreCoord2Id(const Coord & coord)
+{
+    Coord router;
+    router.x = coord.x / concentrationX();
+    int row = coord.y / concentrationY();
+    router.y = row % GlobalParams::mesh_dim_y;
+    router.z = row / GlobalParams::mesh_dim_y;
+    int k = (coord.y % concentrationY()) * concentrationX() + coord.x % concentrationX();
+
+    return coord2Id(router) * GlobalParams::concentration + k;
+}
+
+// Routers of a chiplet edge connected to the neighbouring chiplet
+// through the interposer, as offsets within an edge of size routers.
+// The interposer_links links are spread evenly along the edge
+inline vector < int > interposerPositions(const int size)
+{
+    int n = min(GlobalParams::interposer_links, size);
+    vector < int > positions;
+
+    for (int i = 0; i < n; i++)
+	positions.push_back((2 * i + 1) * size / (2 * n));
+
+    return positions;
+}
+
 inline bool sameRadioHub(int id1, int id2)
 {
     map<int, int>::iterator it1 = GlobalParams::hub_for_tile.find(id1); 
@@ -254,7 +411,7 @@ template<typename T> std::string i_to_string(const T& t){
 
 inline bool YouAreSwitch(int id)
 {
-    if (id < (GlobalParams::n_delta_tiles/2) * log2(GlobalParams::n_delta_tiles))
+    if (id < deltaSwitches() * deltaStages())
     return true;
     else return false;
 }
@@ -13,6 +13,18 @@ class RoutingAlgorithm
 {
 	public:
 		virtual vector<int> route(Router * router, const RouteData & routeData) = 0;
+
+		// Algorithms splitting the virtual channels in a lower (0) and an
+		// upper (1) class return the class to be used on output port out by
+		// a packet of class vc_class coming from port in. NOT_VALID leaves
+		// the virtual channel unchanged
+		virtual int outputVcClass(int in, int vc_class, int out) const { return NOT_VALID; }
+
+		// Algorithms using VC 0 as escape channel (Duato's protocol)
+		// return the output of the deadlock-free escape routing function,
+		// the only one where a packet may take VC 0. NOT_VALID if no
+		// escape channel is used
+		virtual int escapeDirection(const RouteData & routeData) const { return NOT_VALID; }
 };
 
 #endif
@@ -0,0 +1,119 @@
+#include "Routing_CHIPLET_XY.h"
+
+RoutingAlgorithmsRegister Routing_CHIPLET_XY::routingAlgorithmsRegister("CHIPLET_XY", getInstance());
+
+Routing_CHIPLET_XY * Routing_CHIPLET_XY::routing_CHIPLET_XY = 0;
+
+Routing_CHIPLET_XY * Routing_CHIPLET_XY::getInstance() {
+	if ( routing_CHIPLET_XY == 0 )
+		routing_CHIPLET_XY = new Routing_CHIPLET_XY();
+    
+	return routing_CHIPLET_XY;
+}
+
+int Routing_CHIPLET_XY::bestCrossing(const int chiplet, const int size, const int from, const int to,
+				     const int near) const
+{
+    vector < int > positions = interposerPositions(size);
+    int best = NOT_VALID;
+
+    for (unsigned int i = 0; i < positions.size(); i++) {
+	int c = chiplet * size + positions[i];
+	int length = abs(from - c) + abs(c - to);
+	int best_length = abs(from - best) + abs(best - to);
+
+	if (best == NOT_VALID || length < best_length ||
+	    (length == best_length && abs(c - near) < abs(best - near)))
+	    best = c;
+    }
+
+    return best;
+}
+
+// Packets leaving their chiplet are routed XY to an intermediate router
+// I and then XY to the destination. I lies on an interposer column of
+// the source chiplet column and, unless the chiplet column is the same
+// as the destination one, on an interposer row of the destination
+// chiplet row: the first leg crosses the chiplet rows along the column,
+// the second one the chiplet columns along the row
+Coord Routing_CHIPLET_XY::intermediate(const Coord & src, const Coord & dst) const
+{
+    int cw = GlobalParams::chiplet_dim_x;
+    int ch = GlobalParams::chiplet_dim_y;
+    Coord i;
+
+    if (src.x / cw == dst.x / cw && src.y / ch == dst.y / ch)
+	return src;
+
+    if (src.y / ch == dst.y / ch)
+	i.x = src.x;
+    else
+	i.x = bestCrossing(src.x / cw, cw, src.x, dst.x, src.x);
+
+    if (src.x / cw == dst.x / cw)
+	i.y = dst.y;
+    else
+	i.y = bestCrossing(dst.y / ch, ch, src.y, dst.y, dst.y);
+
+    return i;
+}
+
+// Moves c one hop along the XY path towards target
+static void stepXY(Coord & c, const Coord & target)
+{
+    if (c.x != target.x)
+	c.x += (target.x > c.x) ? 1 : -1;
+    else
+	c.y += (target.y > c.y) ? 1 : -1;
+}
+
+// Follows the path src -> I -> dst, which never visits a router twice
+vector<int> Routing_CHIPLET_XY::route(Router * router, const RouteData & routeData)
+{
+    Coord current = id2Coord(routeData.current_id);
+    Coord src = id2Coord(routeData.src_id);
+    Coord dst = id2Coord(routeData.dst_id);
+    Coord inter = intermediate(src, dst);
+    vector <int> directions;
+
+    // Find out the leg the current router belongs to
+    Coord c = src;
+    bool second_leg = (c == inter);
+
+    while (!(c == current)) {
+	assert(!(c == dst));
+	stepXY(c, second_leg ? dst : inter);
+	if (c == inter)
+	    second_leg = true;
+    }
+
+    Coord next = current;
+    stepXY(next, second_leg ? dst : inter);
+
+    if (next.x > current.x)
+	directions.push_back(DIRECTION_EAST);
+    else if (next.x < current.x)
+	directions.push_back(DIRECTION_WEST);
+    else if (next.y > current.y)
+	directions.push_back(DIRECTION_SOUTH);
+    else
+	directions.push_back(DIRECTION_NORTH);
+
+    return directions;
+}
+
+// Both legs are XY, so the only turn from Y to X takes place at the
+// intermediate router: moving there to the upper class keeps the channel
+// dependencies of each class acyclic
+int Routing_CHIPLET_XY::outputVcClass(int in, int vc_class, int out) const
+{
+    bool in_y = (in == DIRECTION_NORTH || in == DIRECTION_SOUTH);
+    bool out_x = (out == DIRECTION_EAST || out == DIRECTION_WEST);
+
+    if (in_y && out_x)
+	return 1;
+    if (in < DIRECTIONS)
+	return vc_class;
+
+    return 0;
+}
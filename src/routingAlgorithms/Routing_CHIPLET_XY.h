@@ -0,0 +1,34 @@
+#ifndef __NOXIMROUTING_CHIPLET_XY_H__
+#define __NOXIMROUTING_CHIPLET_XY_H__
+
+#include "RoutingAlgorithm.h"
+#include "RoutingAlgorithms.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Routing_CHIPLET_XY : RoutingAlgorithm {
+	public:
+		vector<int> route(Router * router, const RouteData & routeData);
+		int outputVcClass(int in, int vc_class, int out) const;
+
+		static Routing_CHIPLET_XY * getInstance();
+
+	private:
+		// Router where the packet leaves the first XY leg
+		Coord intermediate(const Coord & src, const Coord & dst) const;
+
+		// Interposer link of a chiplet minimizing the length of the path
+		// from -> to through it, the nearest to near among the equivalent
+		// ones. Coordinates are global
+		int bestCrossing(const int chiplet, const int size, const int from, const int to,
+				 const int near) const;
+
+		Routing_CHIPLET_XY(){};
+		~Routing_CHIPLET_XY(){};
+
+		static Routing_CHIPLET_XY * routing_CHIPLET_XY;
+		static RoutingAlgorithmsRegister routingAlgorithmsRegister;
+};
+
+#endif
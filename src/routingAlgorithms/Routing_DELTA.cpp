@@ -26,8 +26,12 @@ vector<int> Routing_DELTA::route(Router * router, const RouteData & routeData)
 	// LOG << "I am switch: " <<routeData.current_id << "  _Going to destination: " <<destination<<endl;
 	int currentStage = id2Coord(routeData.current_id).x;
 
-	int shift_amount= log2(GlobalParams::n_delta_tiles)-1-currentStage;
-	int direction = 1 & (destination >> shift_amount);
+	// Destination tag: stage i switches on digit (stages-1-i) of the
+	// destination, in base delta_radix
+	int weight = 1;
+	for (int i = currentStage + 1; i < deltaStages(); i++)
+	    weight *= GlobalParams::delta_radix;
+	int direction = deltaOutputPort((destination / weight) % GlobalParams::delta_radix);
 
 	// LOG << "I am again switch: " <<routeData.current_id << "  _Going to destination: " <<destination<< "  _Via direction "<<direction <<endl;
 
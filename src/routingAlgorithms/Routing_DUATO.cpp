@@ -0,0 +1,45 @@
+#include "Routing_DUATO.h"
+#include "Routing_XY.h"
+
+RoutingAlgorithmsRegister Routing_DUATO::routingAlgorithmsRegister("DUATO", getInstance());
+
+Routing_DUATO * Routing_DUATO::routing_DUATO = 0;
+
+Routing_DUATO * Routing_DUATO::getInstance() {
+	if ( routing_DUATO == 0 )
+		routing_DUATO = new Routing_DUATO();
+    
+	return routing_DUATO;
+}
+
+// All the minimal directions, the escape one first
+vector<int> Routing_DUATO::route(Router * router, const RouteData & routeData)
+{
+    Coord current = id2Coord(routeData.current_id);
+    Coord destination = id2Coord(routeData.dst_id);
+    vector <int> directions;
+
+    if (destination.x > current.x)
+        directions.push_back(DIRECTION_EAST);
+    else if (destination.x < current.x)
+        directions.push_back(DIRECTION_WEST);
+
+    if (destination.y > current.y)
+        directions.push_back(DIRECTION_SOUTH);
+    else if (destination.y < current.y)
+        directions.push_back(DIRECTION_NORTH);
+
+    if (destination.z > current.z)
+        directions.push_back(DIRECTION_UP);
+    else if (destination.z < current.z)
+        directions.push_back(DIRECTION_DOWN);
+
+    assert(directions.size() > 0);
+
+    return directions;
+}
+
+int Routing_DUATO::escapeDirection(const RouteData & routeData) const
+{
+    return Routing_XY::getInstance()->route(NULL, routeData)[0];
+}
@@ -0,0 +1,28 @@
+#ifndef __NOXIMROUTING_DUATO_H__
+#define __NOXIMROUTING_DUATO_H__
+
+#include "RoutingAlgorithm.h"
+#include "RoutingAlgorithms.h"
+#include "../Router.h"
+
+using namespace std;
+
+// Fully adaptive minimal routing following Duato's protocol: VC 0 is
+// the escape channel, routed XY, the other VCs can be taken along any
+// minimal direction
+class Routing_DUATO : RoutingAlgorithm {
+	public:
+		vector<int> route(Router * router, const RouteData & routeData);
+		int escapeDirection(const RouteData & routeData) const;
+
+		static Routing_DUATO * getInstance();
+
+	private:
+		Routing_DUATO(){};
+		~Routing_DUATO(){};
+
+		static Routing_DUATO * routing_DUATO;
+		static RoutingAlgorithmsRegister routingAlgorithmsRegister;
+};
+
+#endif
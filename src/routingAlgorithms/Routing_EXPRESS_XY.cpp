@@ -0,0 +1,49 @@
+#include "Routing_EXPRESS_XY.h"
+
+RoutingAlgorithmsRegister Routing_EXPRESS_XY::routingAlgorithmsRegister("EXPRESS_XY", getInstance());
+
+Routing_EXPRESS_XY * Routing_EXPRESS_XY::routing_EXPRESS_XY = 0;
+
+Routing_EXPRESS_XY * Routing_EXPRESS_XY::getInstance() {
+	if ( routing_EXPRESS_XY == 0 )
+		routing_EXPRESS_XY = new Routing_EXPRESS_XY();
+    
+	return routing_EXPRESS_XY;
+}
+
+// XY routing on a mesh with express channels. Along each dimension the
+// express channel is taken whenever it does not overshoot the
+// destination, otherwise the regular one. Since packets never turn back
+// within a dimension, channels are still crossed in a strict order and
+// the routing is deadlock-free as plain XY
+vector<int> Routing_EXPRESS_XY::route(Router * router, const RouteData & routeData)
+{
+    Coord current = id2Coord(routeData.current_id);
+    Coord destination = id2Coord(routeData.dst_id);
+    TopologyGraph * graph = TopologyGraph::getInstance();
+    vector <int> directions;
+    int dir;
+    int distance;
+
+    if (destination.x > current.x) {
+	dir = DIRECTION_EAST;
+	distance = destination.x - current.x;
+    } else if (destination.x < current.x) {
+	dir = DIRECTION_WEST;
+	distance = current.x - destination.x;
+    } else if (destination.y > current.y) {
+	dir = DIRECTION_SOUTH;
+	distance = destination.y - current.y;
+    } else {
+	dir = DIRECTION_NORTH;
+	distance = current.y - destination.y;
+    }
+
+    if (distance >= GlobalParams::express_interval &&
+	graph->hasOutput(routeData.current_id, DIRECTION_EXPRESS(dir)))
+	directions.push_back(DIRECTION_EXPRESS(dir));
+    else
+	directions.push_back(dir);
+
+    return directions;
+}
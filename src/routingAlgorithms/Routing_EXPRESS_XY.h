@@ -0,0 +1,24 @@
+#ifndef __NOXIMROUTING_EXPRESS_XY_H__
+#define __NOXIMROUTING_EXPRESS_XY_H__
+
+#include "RoutingAlgorithm.h"
+#include "RoutingAlgorithms.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Routing_EXPRESS_XY : RoutingAlgorithm {
+	public:
+		vector<int> route(Router * router, const RouteData & routeData);
+
+		static Routing_EXPRESS_XY * getInstance();
+
+	private:
+		Routing_EXPRESS_XY(){};
+		~Routing_EXPRESS_XY(){};
+
+		static Routing_EXPRESS_XY * routing_EXPRESS_XY;
+		static RoutingAlgorithmsRegister routingAlgorithmsRegister;
+};
+
+#endif
@@ -21,21 +21,24 @@ vector<int> Routing_NEGATIVE_FIRST::route(Router * router, const RouteData & rou
     // Negative directions:
     // WEST (current x > dest x)
     // SOUTH (current y > dest y)
+    // DOWN (current z > dest z), 3D meshes only
     //
     // Algorithm: Never switch from a positive direction to a negative
     // So, any south or west direction should always have priority
 
-    if (destination.x < current.x || destination.y > current.y) // check negative directions first
+    if (destination.x < current.x || destination.y > current.y || destination.z < current.z) // check negative directions first
     {
-	// note: one or both negative directions could be added
+	// note: several negative directions could be added
 	if (destination.x < current.x) directions.push_back(DIRECTION_WEST);
 	if (destination.y > current.y) directions.push_back(DIRECTION_SOUTH);
+	if (destination.z < current.z) directions.push_back(DIRECTION_DOWN);
     } 
     else  // no negative direction to process, check if positive ones are needed
-	if (destination.x > current.x || destination.y < current.y) 
+	if (destination.x > current.x || destination.y < current.y || destination.z > current.z) 
 	{
 	    if (destination.x > current.x) directions.push_back(DIRECTION_EAST);
 	    if (destination.y < current.y) directions.push_back(DIRECTION_NORTH);
+	    if (destination.z > current.z) directions.push_back(DIRECTION_UP);
 	} 
 	else // both x and y were already reached
 	    directions.push_back(DIRECTION_LOCAL);
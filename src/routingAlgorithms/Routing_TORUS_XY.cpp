@@ -0,0 +1,46 @@
+#include "Routing_TORUS_XY.h"
+
+RoutingAlgorithmsRegister Routing_TORUS_XY::routingAlgorithmsRegister("TORUS_XY", getInstance());
+
+Routing_TORUS_XY * Routing_TORUS_XY::routing_TORUS_XY = 0;
+
+Routing_TORUS_XY * Routing_TORUS_XY::getInstance() {
+	if ( routing_TORUS_XY == 0 )
+		routing_TORUS_XY = new Routing_TORUS_XY();
+    
+	return routing_TORUS_XY;
+}
+
+// Dimension-order routing along the shortest way around each ring.
+// Ties are broken towards EAST/SOUTH. Deadlock freedom relies on the
+// dateline VC classes applied by the router on the wraparound links
+vector<int> Routing_TORUS_XY::route(Router * router, const RouteData & routeData)
+{
+    Coord current = id2Coord(routeData.current_id);
+    Coord destination = id2Coord(routeData.dst_id);
+    vector <int> directions;
+
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+
+    if (destination.x != current.x)
+    {
+	int east_hops = (destination.x - current.x + dimx) % dimx;
+
+	if (east_hops <= dimx - east_hops)
+	    directions.push_back(DIRECTION_EAST);
+	else
+	    directions.push_back(DIRECTION_WEST);
+    }
+    else
+    {
+	int south_hops = (destination.y - current.y + dimy) % dimy;
+
+	if (south_hops <= dimy - south_hops)
+	    directions.push_back(DIRECTION_SOUTH);
+	else
+	    directions.push_back(DIRECTION_NORTH);
+    }
+
+    return directions;
+}
@@ -0,0 +1,24 @@
+#ifndef __NOXIMROUTING_TORUS_XY_H__
+#define __NOXIMROUTING_TORUS_XY_H__
+
+#include "RoutingAlgorithm.h"
+#include "RoutingAlgorithms.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Routing_TORUS_XY : RoutingAlgorithm {
+	public:
+		vector<int> route(Router * router, const RouteData & routeData);
+
+		static Routing_TORUS_XY * getInstance();
+
+	private:
+		Routing_TORUS_XY(){};
+		~Routing_TORUS_XY(){};
+
+		static Routing_TORUS_XY * routing_TORUS_XY;
+		static RoutingAlgorithmsRegister routingAlgorithmsRegister;
+};
+
+#endif
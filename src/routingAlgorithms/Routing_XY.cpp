@@ -11,6 +11,7 @@ Routing_XY * Routing_XY::getInstance() {
 	return routing_XY;
 }
 
+// Dimension order routing: X first, then Y and, on 3D meshes, Z
 vector<int> Routing_XY::route(Router * router, const RouteData & routeData)
 {
     Coord current = id2Coord(routeData.current_id);
@@ -23,6 +24,12 @@ vector<int> Routing_XY::route(Router * router, const RouteData & routeData)
         directions.push_back(DIRECTION_WEST);
     else if (destination.y > current.y)
         directions.push_back(DIRECTION_SOUTH);
+    else if (destination.y < current.y)
+        directions.push_back(DIRECTION_NORTH);
+    else if (destination.z > current.z)
+        directions.push_back(DIRECTION_UP);
+    else if (destination.z < current.z)
+        directions.push_back(DIRECTION_DOWN);
     else
         directions.push_back(DIRECTION_NORTH);
 
@@ -20,6 +20,14 @@ int Selection_BUFFER_LEVEL::apply(Router * router, const vector < int >&directio
 
 	int free_slots = router->free_slots_neighbor[directions[i]].read();
 
+	// With several VCs, the free slots of all of them downstream
+	if (GlobalParams::n_virtual_channels > 1) {
+	    const TBufferFullStatus & bfs = router->buffer_full_status_tx[directions[i]].read();
+	    free_slots = 0;
+	    for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+		free_slots += bfs.free_slots[vc];
+	}
+
 	try {
 	    available = router->reservation_table.isNotReserved(directions[i]);
 	}
@@ -86,7 +94,7 @@ int Selection_BUFFER_LEVEL::apply(Router * router, const vector < int >&directio
 
 void Selection_BUFFER_LEVEL::perCycleUpdate(Router * router) {
 	    // update current input buffers level to neighbors
-	    for (int i = 0; i < DIRECTIONS + 1; i++)
+	    for (int i = 0; i < router->n_ports; i++)
 		router->free_slots[i].write(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
 
 	    // NoP selection: send neighbor info to each direction 'i'
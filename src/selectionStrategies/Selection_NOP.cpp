@@ -66,7 +66,7 @@ int Selection_NOP::apply(Router * router, const vector < int >&directions, const
 
 void Selection_NOP::perCycleUpdate(Router * router) {
 	    // update current input buffers level to neighbors
-	    for (int i = 0; i < DIRECTIONS + 1; i++)
+	    for (int i = 0; i < router->n_ports; i++)
 		router->free_slots[i].write(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
 
 	    // NoP selection: send neighbor info to each direction 'i'
@@ -0,0 +1,67 @@
+#include "Selection_RCA.h"
+
+SelectionStrategiesRegister Selection_RCA::selectionStrategiesRegister("RCA", getInstance());
+
+Selection_RCA * Selection_RCA::selection_RCA = 0;
+
+Selection_RCA * Selection_RCA::getInstance() {
+	if ( selection_RCA == 0 )
+		selection_RCA = new Selection_RCA();
+
+	return selection_RCA;
+}
+
+double Selection_RCA::regionalFreeSlots(Router * router, const int d) const {
+    if (!TopologyGraph::getInstance()->hasOutput(router->local_id, d))
+	return NOT_VALID;
+
+    // Free slots of all the VCs of the downstream input
+    const TBufferFullStatus & bfs = router->buffer_full_status_tx[d].read();
+    int local = 0;
+    for (int vc = 0; vc < GlobalParams::n_virtual_channels; vc++)
+	local += bfs.free_slots[vc];
+
+    // Ports with no NoP side-band (3D, extra ports) and edges of the
+    // region only see the next router
+    if (d >= DIRECTIONS)
+	return local;
+
+    double remote = router->NoP_data_in[d].read().regional_free_slots[d];
+    if (remote < 0)
+	return local;
+
+    return (local + remote) / 2;
+}
+
+int Selection_RCA::apply(Router * router, const vector < int >&directions, const RouteData & route_data) {
+    vector < int >best_dirs;
+    double max_free_slots = NOT_VALID;
+
+    for (unsigned int i = 0; i < directions.size(); i++) {
+	double free_slots = regionalFreeSlots(router, directions[i]);
+
+	if (free_slots > max_free_slots) {
+	    max_free_slots = free_slots;
+	    best_dirs.clear();
+	}
+	if (free_slots == max_free_slots)
+	    best_dirs.push_back(directions[i]);
+    }
+
+    return best_dirs[rand() % best_dirs.size()];
+}
+
+void Selection_RCA::perCycleUpdate(Router * router) {
+	    // update current input buffers level to neighbors
+	    for (int i = 0; i < router->n_ports; i++)
+		router->free_slots[i].write(router->buffer[i][DEFAULT_VC].getCurrentFreeSlots());
+
+	    // Propagate the regional congestion to every neighbor
+	    NoP_data current_NoP_data = router->getCurrentNoPData();
+
+	    for (int d = 0; d < DIRECTIONS; d++)
+		current_NoP_data.regional_free_slots[d] = regionalFreeSlots(router, d);
+
+	    for (int i = 0; i < DIRECTIONS; i++)
+		router->NoP_data_out[i].write(current_NoP_data);
+}
@@ -0,0 +1,34 @@
+#ifndef __NOXIMSELECTION_RCA_H__
+#define __NOXIMSELECTION_RCA_H__
+
+#include "SelectionStrategy.h"
+#include "SelectionStrategies.h"
+#include "../Router.h"
+#include "../TopologyGraph.h"
+
+using namespace std;
+
+// Regional Congestion Awareness (RCA-1D). Each router sends upstream, on
+// the NoP side-band, the free slots along each direction: the ones of its
+// own downstream router averaged with the value received from it, so
+// that farther routers weigh half as much at each hop and information
+// travels one hop per cycle. Outputs are selected by the regional value
+class Selection_RCA : SelectionStrategy {
+	public:
+        int apply(Router * router, const vector < int >&directions, const RouteData & route_data);
+        void perCycleUpdate(Router * router);
+
+		static Selection_RCA * getInstance();
+
+	private:
+		Selection_RCA(){};
+		~Selection_RCA(){};
+
+		// Free slots along direction d, NOT_VALID without a link
+		double regionalFreeSlots(Router * router, const int d) const;
+
+		static Selection_RCA * selection_RCA;
+		static SelectionStrategiesRegister selectionStrategiesRegister;
+};
+
+#endif
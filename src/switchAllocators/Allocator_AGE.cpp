@@ -0,0 +1,36 @@
+#include <algorithm>
+#include "Allocator_AGE.h"
+
+SwitchAllocatorsRegister Allocator_AGE::switchAllocatorsRegister("AGE", getInstance());
+
+Allocator_AGE * Allocator_AGE::allocator_AGE = 0;
+
+Allocator_AGE * Allocator_AGE::getInstance() {
+	if ( allocator_AGE == 0 )
+		allocator_AGE = new Allocator_AGE();
+
+	return allocator_AGE;
+}
+
+// Age-based allocation: the requests are granted from the oldest packet,
+// i.e. the earliest generated, whatever its traffic class. Packets waiting
+// longer in the network are not starved by younger ones
+vector<int> Allocator_AGE::allocate(Router * router, const vector<SARequest> & requests)
+{
+    vector< pair<double, int> > priority;
+
+    for (unsigned int r = 0; r < requests.size(); r++)
+	if (requests[r].ready)
+	{
+	    const Flit & flit = router->buffer[requests[r].input][requests[r].vc].Front();
+	    priority.push_back(make_pair(flit.timestamp, r));
+	}
+
+    sort(priority.begin(), priority.end());
+
+    vector<int> order;
+    for (unsigned int k = 0; k < priority.size(); k++)
+	order.push_back(priority[k].second);
+
+    return priorityMatching(requests, order);
+}
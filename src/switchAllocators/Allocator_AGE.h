@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_AGE_H__
+#define __NOXIMALLOCATOR_AGE_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_AGE : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_AGE * getInstance();
+
+	private:
+		Allocator_AGE(){};
+		~Allocator_AGE(){};
+
+		static Allocator_AGE * allocator_AGE;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include <algorithm>
+#include "Allocator_CLASS.h"
+
+SwitchAllocatorsRegister Allocator_CLASS::switchAllocatorsRegister("CLASS", getInstance());
+
+Allocator_CLASS * Allocator_CLASS::allocator_CLASS = 0;
+
+Allocator_CLASS * Allocator_CLASS::getInstance() {
+	if ( allocator_CLASS == 0 )
+		allocator_CLASS = new Allocator_CLASS();
+
+	return allocator_CLASS;
+}
+
+// Strict priority allocation: the requests are granted from the lowest
+// traffic class, and within a class from the oldest packet, so that
+// bulk traffic never takes an output a higher priority flit could use
+vector<int> Allocator_CLASS::allocate(Router * router, const vector<SARequest> & requests)
+{
+    vector< pair< pair<int, double>, int > > priority;
+
+    for (unsigned int r = 0; r < requests.size(); r++)
+	if (requests[r].ready)
+	{
+	    const Flit & flit = router->buffer[requests[r].input][requests[r].vc].Front();
+	    priority.push_back(make_pair(make_pair(flit.traffic_class, flit.timestamp), r));
+	}
+
+    sort(priority.begin(), priority.end());
+
+    vector<int> order;
+    for (unsigned int k = 0; k < priority.size(); k++)
+	order.push_back(priority[k].second);
+
+    return priorityMatching(requests, order);
+}
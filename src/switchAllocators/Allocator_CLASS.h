@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_CLASS_H__
+#define __NOXIMALLOCATOR_CLASS_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_CLASS : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_CLASS * getInstance();
+
+	private:
+		Allocator_CLASS(){};
+		~Allocator_CLASS(){};
+
+		static Allocator_CLASS * allocator_CLASS;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
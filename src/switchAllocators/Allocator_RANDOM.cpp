@@ -0,0 +1,71 @@
+#include "Allocator_RANDOM.h"
+
+SwitchAllocatorsRegister Allocator_RANDOM::switchAllocatorsRegister("RANDOM", getInstance());
+
+Allocator_RANDOM * Allocator_RANDOM::allocator_RANDOM = 0;
+
+Allocator_RANDOM * Allocator_RANDOM::getInstance() {
+	if ( allocator_RANDOM == 0 )
+		allocator_RANDOM = new Allocator_RANDOM();
+
+	return allocator_RANDOM;
+}
+
+// Each input picks at random one of the outputs whose highest priority
+// reservation is its own, outputs rotating their priority over time
+// (see ReservationTable::updateIndex). The choice ignores whether the
+// flit can actually be forwarded. Inputs choose in order, each one
+// seeing the outputs released by the tails granted before it, as the
+// router did when it forwarded the flits input by input
+vector<int> Allocator_RANDOM::allocate(Router * router, const vector<SARequest> & requests)
+{
+    vector<int> grants;
+
+    // Requests for each output in reservation order, and position of
+    // the one having the highest priority
+    vector< vector<int> > reservations(router->n_ports);
+    vector<int> index(router->n_ports, NOT_VALID);
+    vector<bool> granted(router->n_ports, false);
+
+    for (unsigned int r = 0; r < requests.size(); r++)
+    {
+	int o = requests[r].output;
+
+	if (requests[r].current)
+	    index[o] = reservations[o].size();
+	reservations[o].push_back(r);
+    }
+
+    for (int i = 0; i < router->n_ports; i++)
+    {
+	vector<int> candidates;
+
+	for (int o = 0; o < router->n_ports; o++)
+	    if (index[o] != NOT_VALID && requests[reservations[o][index[o]]].input == i)
+		candidates.push_back(reservations[o][index[o]]);
+
+	if (candidates.size() != 0)
+	{
+	    int r = candidates[rand() % candidates.size()];
+	    int o = requests[r].output;
+
+	    if (requests[r].ready && !granted[o])
+	    {
+		grants.push_back(r);
+		granted[o] = true;
+
+		// Same update of the priority as ReservationTable::release
+		if (requests[r].tail)
+		{
+		    reservations[o].erase(reservations[o].begin() + index[o]);
+		    if (reservations[o].empty())
+			index[o] = NOT_VALID;
+		    else if (index[o] >= (int) reservations[o].size())
+			index[o] = 0;
+		}
+	    }
+	}
+    }
+
+    return grants;
+}
@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_RANDOM_H__
+#define __NOXIMALLOCATOR_RANDOM_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_RANDOM : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_RANDOM * getInstance();
+
+	private:
+		Allocator_RANDOM(){};
+		~Allocator_RANDOM(){};
+
+		static Allocator_RANDOM * allocator_RANDOM;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "Allocator_SEPARABLE_IF.h"
+
+SwitchAllocatorsRegister Allocator_SEPARABLE_IF::switchAllocatorsRegister("SEPARABLE_IF", getInstance());
+
+Allocator_SEPARABLE_IF * Allocator_SEPARABLE_IF::allocator_SEPARABLE_IF = 0;
+
+Allocator_SEPARABLE_IF * Allocator_SEPARABLE_IF::getInstance() {
+	if ( allocator_SEPARABLE_IF == 0 )
+		allocator_SEPARABLE_IF = new Allocator_SEPARABLE_IF();
+
+	return allocator_SEPARABLE_IF;
+}
+
+// Separable input-first allocation: a round-robin arbiter at each input
+// picks one of its ready VCs, then a round-robin arbiter at each output
+// picks one of the inputs that chose it. As in iSLIP, the pointers only
+// move past the winners of both arbitrations
+vector<int> Allocator_SEPARABLE_IF::allocate(Router * router, const vector<SARequest> & requests)
+{
+    int n_vcs = GlobalParams::n_virtual_channels;
+    vector<int> choice(router->n_ports, NOT_VALID);
+    vector<int> grants;
+
+    for (int i = 0; i < router->n_ports; i++)
+    {
+	vector<bool> vcs(n_vcs, false);
+	vector<int> request_of_vc(n_vcs, NOT_VALID);
+
+	for (unsigned int r = 0; r < requests.size(); r++)
+	    if (requests[r].input == i && requests[r].ready)
+	    {
+		vcs[requests[r].vc] = true;
+		request_of_vc[requests[r].vc] = r;
+	    }
+
+	int vc = roundRobin(vcs, router->sa_vc_ptr[i]);
+	if (vc != NOT_VALID)
+	    choice[i] = request_of_vc[vc];
+    }
+
+    for (int o = 0; o < router->n_ports; o++)
+    {
+	vector<bool> inputs(router->n_ports, false);
+
+	for (int i = 0; i < router->n_ports; i++)
+	    inputs[i] = (choice[i] != NOT_VALID && requests[choice[i]].output == o);
+
+	int i = roundRobin(inputs, router->sa_output_ptr[o]);
+	if (i != NOT_VALID)
+	{
+	    grants.push_back(choice[i]);
+	    router->sa_vc_ptr[i] = (requests[choice[i]].vc + 1) % n_vcs;
+	    router->sa_output_ptr[o] = (i + 1) % router->n_ports;
+	}
+    }
+
+    return grants;
+}
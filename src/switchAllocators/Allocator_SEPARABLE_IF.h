@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_SEPARABLE_IF_H__
+#define __NOXIMALLOCATOR_SEPARABLE_IF_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_SEPARABLE_IF : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_SEPARABLE_IF * getInstance();
+
+	private:
+		Allocator_SEPARABLE_IF(){};
+		~Allocator_SEPARABLE_IF(){};
+
+		static Allocator_SEPARABLE_IF * allocator_SEPARABLE_IF;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
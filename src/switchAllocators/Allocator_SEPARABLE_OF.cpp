@@ -0,0 +1,67 @@
+#include "Allocator_SEPARABLE_OF.h"
+
+SwitchAllocatorsRegister Allocator_SEPARABLE_OF::switchAllocatorsRegister("SEPARABLE_OF", getInstance());
+
+Allocator_SEPARABLE_OF * Allocator_SEPARABLE_OF::allocator_SEPARABLE_OF = 0;
+
+Allocator_SEPARABLE_OF * Allocator_SEPARABLE_OF::getInstance() {
+	if ( allocator_SEPARABLE_OF == 0 )
+		allocator_SEPARABLE_OF = new Allocator_SEPARABLE_OF();
+
+	return allocator_SEPARABLE_OF;
+}
+
+// Separable output-first allocation (single iteration iSLIP): a
+// round-robin arbiter at each output grants one of the requesting
+// inputs, then a round-robin arbiter at each input accepts one of the
+// granting outputs, and the VC to serve among the ones requesting it.
+// The pointers only move past accepted grants
+vector<int> Allocator_SEPARABLE_OF::allocate(Router * router, const vector<SARequest> & requests)
+{
+    int n_vcs = GlobalParams::n_virtual_channels;
+    vector<int> granted_input(router->n_ports, NOT_VALID);
+    vector<int> grants;
+
+    for (int o = 0; o < router->n_ports; o++)
+    {
+	vector<bool> inputs(router->n_ports, false);
+
+	for (unsigned int r = 0; r < requests.size(); r++)
+	    if (requests[r].output == o && requests[r].ready)
+		inputs[requests[r].input] = true;
+
+	granted_input[o] = roundRobin(inputs, router->sa_output_ptr[o]);
+    }
+
+    for (int i = 0; i < router->n_ports; i++)
+    {
+	vector<bool> outputs(router->n_ports, false);
+
+	for (int o = 0; o < router->n_ports; o++)
+	    outputs[o] = (granted_input[o] == i);
+
+	int o = roundRobin(outputs, router->sa_input_ptr[i]);
+	if (o == NOT_VALID)
+	    continue;
+
+	vector<bool> vcs(n_vcs, false);
+	vector<int> request_of_vc(n_vcs, NOT_VALID);
+
+	for (unsigned int r = 0; r < requests.size(); r++)
+	    if (requests[r].input == i && requests[r].output == o && requests[r].ready)
+	    {
+		vcs[requests[r].vc] = true;
+		request_of_vc[requests[r].vc] = r;
+	    }
+
+	int vc = roundRobin(vcs, router->sa_vc_ptr[i]);
+	assert(vc != NOT_VALID);
+
+	grants.push_back(request_of_vc[vc]);
+	router->sa_output_ptr[o] = (i + 1) % router->n_ports;
+	router->sa_input_ptr[i] = (o + 1) % router->n_ports;
+	router->sa_vc_ptr[i] = (vc + 1) % n_vcs;
+    }
+
+    return grants;
+}
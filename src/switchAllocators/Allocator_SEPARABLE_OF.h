@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_SEPARABLE_OF_H__
+#define __NOXIMALLOCATOR_SEPARABLE_OF_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_SEPARABLE_OF : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_SEPARABLE_OF * getInstance();
+
+	private:
+		Allocator_SEPARABLE_OF(){};
+		~Allocator_SEPARABLE_OF(){};
+
+		static Allocator_SEPARABLE_OF * allocator_SEPARABLE_OF;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "Allocator_WAVEFRONT.h"
+
+SwitchAllocatorsRegister Allocator_WAVEFRONT::switchAllocatorsRegister("WAVEFRONT", getInstance());
+
+Allocator_WAVEFRONT * Allocator_WAVEFRONT::allocator_WAVEFRONT = 0;
+
+Allocator_WAVEFRONT * Allocator_WAVEFRONT::getInstance() {
+	if ( allocator_WAVEFRONT == 0 )
+		allocator_WAVEFRONT = new Allocator_WAVEFRONT();
+
+	return allocator_WAVEFRONT;
+}
+
+// Wavefront allocation: the cells (input, output) of the request matrix
+// are visited by diagonals, starting from the highest priority one, and
+// a request is granted when neither its row nor its column has been
+// granted yet. The priority diagonal moves every cycle. The VC to serve
+// is then chosen round-robin among the ones requesting the output
+vector<int> Allocator_WAVEFRONT::allocate(Router * router, const vector<SARequest> & requests)
+{
+    int n = router->n_ports;
+    int n_vcs = GlobalParams::n_virtual_channels;
+    vector< vector<bool> > request_matrix(n, vector<bool>(n, false));
+    vector<bool> row_free(n, true);
+    vector<bool> column_free(n, true);
+    vector<int> grants;
+
+    for (unsigned int r = 0; r < requests.size(); r++)
+	if (requests[r].ready)
+	    request_matrix[requests[r].input][requests[r].output] = true;
+
+    for (int k = 0; k < n; k++)
+    {
+	int d = (router->sa_priority + k) % n;
+
+	for (int i = 0; i < n; i++)
+	{
+	    int o = (i + d) % n;
+
+	    if (!request_matrix[i][o] || !row_free[i] || !column_free[o])
+		continue;
+
+	    row_free[i] = false;
+	    column_free[o] = false;
+
+	    vector<bool> vcs(n_vcs, false);
+	    vector<int> request_of_vc(n_vcs, NOT_VALID);
+
+	    for (unsigned int r = 0; r < requests.size(); r++)
+		if (requests[r].input == i && requests[r].output == o && requests[r].ready)
+		{
+		    vcs[requests[r].vc] = true;
+		    request_of_vc[requests[r].vc] = r;
+		}
+
+	    int vc = roundRobin(vcs, router->sa_vc_ptr[i]);
+	    assert(vc != NOT_VALID);
+
+	    grants.push_back(request_of_vc[vc]);
+	    router->sa_vc_ptr[i] = (vc + 1) % n_vcs;
+	}
+    }
+
+    router->sa_priority = (router->sa_priority + 1) % n;
+
+    return grants;
+}
@@ -0,0 +1,24 @@
+#ifndef __NOXIMALLOCATOR_WAVEFRONT_H__
+#define __NOXIMALLOCATOR_WAVEFRONT_H__
+
+#include "SwitchAllocator.h"
+#include "SwitchAllocators.h"
+#include "../Router.h"
+
+using namespace std;
+
+class Allocator_WAVEFRONT : SwitchAllocator {
+	public:
+        vector<int> allocate(Router * router, const vector<SARequest> & requests);
+
+		static Allocator_WAVEFRONT * getInstance();
+
+	private:
+		Allocator_WAVEFRONT(){};
+		~Allocator_WAVEFRONT(){};
+
+		static Allocator_WAVEFRONT * allocator_WAVEFRONT;
+		static SwitchAllocatorsRegister switchAllocatorsRegister;
+};
+
+#endif
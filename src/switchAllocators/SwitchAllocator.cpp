@@ -0,0 +1,82 @@
+#include <set>
+#include "SwitchAllocator.h"
+
+int SwitchAllocator::roundRobin(const vector<bool> & candidates, const int start)
+{
+    int n = candidates.size();
+
+    for (int k = 0; k < n; k++) {
+	int c = (start + k) % n;
+	if (candidates[c])
+	    return c;
+    }
+
+    return NOT_VALID;
+}
+
+vector<int> SwitchAllocator::priorityMatching(const vector<SARequest> & requests, const vector<int> & order)
+{
+    set<int> inputs, outputs;
+    vector<int> grants;
+
+    for (unsigned int k = 0; k < order.size(); k++) {
+	const SARequest & q = requests[order[k]];
+
+	if (!q.ready || inputs.count(q.input) || outputs.count(q.output))
+	    continue;
+
+	inputs.insert(q.input);
+	outputs.insert(q.output);
+	grants.push_back(order[k]);
+    }
+
+    return grants;
+}
+
+bool SwitchAllocator::augment(const vector< vector<int> > & adjacency, const int input,
+			      vector<int> & matched_input, vector<bool> & visited)
+{
+    for (unsigned int k = 0; k < adjacency[input].size(); k++) {
+	int o = adjacency[input][k];
+
+	if (visited[o])
+	    continue;
+	visited[o] = true;
+
+	if (matched_input[o] == NOT_VALID || augment(adjacency, matched_input[o], matched_input, visited)) {
+	    matched_input[o] = input;
+	    return true;
+	}
+    }
+
+    return false;
+}
+
+int SwitchAllocator::maximumMatching(const vector<SARequest> & requests)
+{
+    int n_inputs = 0, n_outputs = 0;
+
+    for (unsigned int r = 0; r < requests.size(); r++) {
+	n_inputs = max(n_inputs, requests[r].input + 1);
+	n_outputs = max(n_outputs, requests[r].output + 1);
+    }
+
+    vector< vector<int> > adjacency(n_inputs);
+
+    for (unsigned int r = 0; r < requests.size(); r++)
+	if (requests[r].ready)
+	    adjacency[requests[r].input].push_back(requests[r].output);
+
+    // Augmenting paths (Kuhn)
+    vector<int> matched_input(n_outputs, NOT_VALID);
+    int matching = 0;
+
+    for (int i = 0; i < n_inputs; i++) {
+	vector<bool> visited(n_outputs, false);
+
+	if (augment(adjacency, i, matched_input, visited))
+	    matching++;
+    }
+
+    return matching;
+}
@@ -0,0 +1,50 @@
+#ifndef __NOXIMSWITCHALLOCATOR_H__
+#define __NOXIMSWITCHALLOCATOR_H__
+
+#include <vector>
+#include "../DataStructs.h"
+#include "../Utils.h"
+
+using namespace std;
+
+struct Router;
+
+// Request of an input VC for the output it has reserved
+struct SARequest
+{
+    int input;
+    int vc;
+    int output;
+    int out_vc;		// VC reserved on the output
+    bool current;	// At the highest priority index of the output reservations
+    bool ready;		// A flit can be forwarded in this cycle
+    bool tail;		// The flit is the tail, which releases the output
+};
+
+class SwitchAllocator
+{
+	public:
+        // Returns the indexes of the granted requests, at most one for
+        // each input and for each output. Only ready requests may be
+        // granted
+        virtual vector<int> allocate(Router * router, const vector<SARequest> & requests) = 0;
+
+        // Size of a maximum matching of inputs and outputs over the
+        // ready requests, i.e. the best any allocator could do
+        static int maximumMatching(const vector<SARequest> & requests);
+
+	protected:
+        // First true candidate at or after start, in circular order.
+        // Returns NOT_VALID if none
+        static int roundRobin(const vector<bool> & candidates, const int start);
+
+        // Grants the ready requests in the given order of priority,
+        // skipping the ones whose input or output is already granted
+        static vector<int> priorityMatching(const vector<SARequest> & requests, const vector<int> & order);
+
+	private:
+        static bool augment(const vector< vector<int> > & adjacency, const int input,
+                            vector<int> & matched_input, vector<bool> & visited);
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "SwitchAllocators.h"
+
+SwitchAllocatorsMap * SwitchAllocators::switchAllocatorsMap = 0;
+
+SwitchAllocator * SwitchAllocators::get(const string & switchAllocatorName) {
+	SwitchAllocatorsMap::iterator it = getSwitchAllocatorsMap()->find(switchAllocatorName);
+
+	if(it == getSwitchAllocatorsMap()->end())
+		return 0;
+
+	return it->second;
+}
+
+SwitchAllocatorsMap * SwitchAllocators::getSwitchAllocatorsMap() {
+	if(switchAllocatorsMap == 0)
+		switchAllocatorsMap = new SwitchAllocatorsMap();
+
+	return switchAllocatorsMap;
+}
@@ -0,0 +1,26 @@
+#ifndef __NOXIMSWITCHALLOCATORS_H__
+#define __NOXIMSWITCHALLOCATORS_H__
+
+#include <map>
+#include <string>
+#include "SwitchAllocator.h"
+
+using namespace std;
+
+typedef map<string, SwitchAllocator* > SwitchAllocatorsMap;
+
+class SwitchAllocators {
+	public:
+		static SwitchAllocatorsMap * switchAllocatorsMap;
+		static SwitchAllocatorsMap * getSwitchAllocatorsMap();
+
+		static SwitchAllocator * get(const string & switchAllocatorName);
+};
+
+struct SwitchAllocatorsRegister : SwitchAllocators {
+	SwitchAllocatorsRegister(const string & switchAllocatorName, SwitchAllocator * switchAllocator) {
+		getSwitchAllocatorsMap()->insert(make_pair(switchAllocatorName, switchAllocator));
+	}
+};
+
+#endif
@@ -0,0 +1,18 @@
+#include "Topologies.h"
+
+TopologiesMap * Topologies::topologiesMap = 0;
+
+Topology * Topologies::get(const string & topologyName) {
+	TopologiesMap::iterator it = getTopologiesMap()->find(topologyName);
+
+	if(it == getTopologiesMap()->end())
+		return 0;
+
+	return it->second;
+}
+
+TopologiesMap * Topologies::getTopologiesMap() {
+	if(topologiesMap == 0) 
+		topologiesMap = new TopologiesMap();
+	return topologiesMap; 
+}
@@ -0,0 +1,26 @@
+#ifndef __NOXIMTOPOLOGIES_H__
+#define __NOXIMTOPOLOGIES_H__
+
+#include <map>
+#include <string>
+#include "Topology.h"
+
+using namespace std;
+
+typedef map<string, Topology * > TopologiesMap;
+
+class Topologies {
+	public:
+		static TopologiesMap * topologiesMap;
+		static TopologiesMap * getTopologiesMap();
+
+		static Topology * get(const string & topologyName);
+};
+
+struct TopologiesRegister : Topologies {
+	TopologiesRegister(const string & topologyName, Topology * topology) {
+		getTopologiesMap()->insert(make_pair(topologyName, topology));
+	}
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef __NOXIMTOPOLOGY_H__
+#define __NOXIMTOPOLOGY_H__
+
+#include "../TopologyGraph.h"
+
+using namespace std;
+
+class Topology
+{
+	public:
+		// Fills the graph with the nodes and links of the topology
+		virtual void build(TopologyGraph * graph) = 0;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include "Topology_BASELINE.h"
+
+TopologiesRegister Topology_BASELINE::topologiesRegister(TOPOLOGY_BASELINE, getInstance());
+
+Topology_BASELINE * Topology_BASELINE::topology_BASELINE = 0;
+
+Topology_BASELINE * Topology_BASELINE::getInstance() {
+	if ( topology_BASELINE == 0 )
+		topology_BASELINE = new Topology_BASELINE();
+    
+	return topology_BASELINE;
+}
+
+// Inverse shuffle (rotate right the line by one digit) after the first
+// stage, then the same exchanges of the butterfly
+int Topology_BASELINE::permutation(const int line, const int stage, const int stages)
+{
+    if (stage == 0)
+	return line / GlobalParams::delta_radix + digit(line, 0) * power(stages - 1);
+
+    int i = stages - 1 - stage;
+
+    return setDigit(setDigit(line, i, digit(line, 0)), 0, digit(line, i));
+}
@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_BASELINE_H__
+#define __NOXIMTOPOLOGY_BASELINE_H__
+
+#include "Topology_DELTA.h"
+
+using namespace std;
+
+class Topology_BASELINE : Topology_DELTA {
+	public:
+		static Topology_BASELINE * getInstance();
+
+	protected:
+		int permutation(const int line, const int stage, const int stages);
+
+	private:
+		Topology_BASELINE(){};
+		~Topology_BASELINE(){};
+
+		static Topology_BASELINE * topology_BASELINE;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#include "Topology_BUTTERFLY.h"
+
+TopologiesRegister Topology_BUTTERFLY::topologiesRegister(TOPOLOGY_BUTTERFLY, getInstance());
+
+Topology_BUTTERFLY * Topology_BUTTERFLY::topology_BUTTERFLY = 0;
+
+Topology_BUTTERFLY * Topology_BUTTERFLY::getInstance() {
+	if ( topology_BUTTERFLY == 0 )
+		topology_BUTTERFLY = new Topology_BUTTERFLY();
+    
+	return topology_BUTTERFLY;
+}
+
+// Exchange the least significant digit with digit (stages-1-stage)
+int Topology_BUTTERFLY::permutation(const int line, const int stage, const int stages)
+{
+    int i = stages - 1 - stage;
+
+    return setDigit(setDigit(line, i, digit(line, 0)), 0, digit(line, i));
+}
@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_BUTTERFLY_H__
+#define __NOXIMTOPOLOGY_BUTTERFLY_H__
+
+#include "Topology_DELTA.h"
+
+using namespace std;
+
+class Topology_BUTTERFLY : Topology_DELTA {
+	public:
+		static Topology_BUTTERFLY * getInstance();
+
+	protected:
+		int permutation(const int line, const int stage, const int stages);
+
+	private:
+		Topology_BUTTERFLY(){};
+		~Topology_BUTTERFLY(){};
+
+		static Topology_BUTTERFLY * topology_BUTTERFLY;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "Topology_CHIPLET.h"
+#include "../Utils.h"
+
+TopologiesRegister Topology_CHIPLET::topologiesRegister(TOPOLOGY_CHIPLET, getInstance());
+
+Topology_CHIPLET * Topology_CHIPLET::topology_CHIPLET = 0;
+
+Topology_CHIPLET * Topology_CHIPLET::getInstance() {
+	if ( topology_CHIPLET == 0 )
+		topology_CHIPLET = new Topology_CHIPLET();
+    
+	return topology_CHIPLET;
+}
+
+// The mesh_dim_x * mesh_dim_y routers are split in chiplets of
+// chiplet_dim_x * chiplet_dim_y routers. Each chiplet is a mesh, while
+// neighbouring chiplets are connected only by interposer_links links per
+// edge, which are longer, slower and possibly narrower than the on-chip ones
+void Topology_CHIPLET::build(TopologyGraph * graph)
+{
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+    int cw = GlobalParams::chiplet_dim_x;
+    int ch = GlobalParams::chiplet_dim_y;
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    char tile_name[64];
+	    Coord tile_coord;
+	    tile_coord.x = i;
+	    tile_coord.y = j;
+	    int tile_id = j * dimx + i;
+	    sprintf(tile_name, "Tile[%02d][%02d]_(#%d)", i, j, tile_id);
+	    graph->addNode(tile_id, tile_coord, false, tile_name);
+	}
+
+    // On-chip links
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    int id = j * dimx + i;
+
+	    if (i < dimx - 1 && (i + 1) % cw != 0)
+		graph->addChannel(id, DIRECTION_EAST, id + 1, DIRECTION_WEST, GlobalParams::r2r_link_length);
+	    if (j < dimy - 1 && (j + 1) % ch != 0)
+		graph->addChannel(id, DIRECTION_SOUTH, id + dimx, DIRECTION_NORTH, GlobalParams::r2r_link_length);
+	}
+
+    // Interposer links between the boundary routers of neighbouring chiplets
+    vector < int > rows = interposerPositions(ch);
+    vector < int > columns = interposerPositions(cw);
+
+    for (int i = cw - 1; i < dimx - 1; i += cw)
+	for (int j = 0; j < dimy; j += ch)
+	    for (unsigned int k = 0; k < rows.size(); k++)
+	    {
+		int id = (j + rows[k]) * dimx + i;
+		graph->addChannel(id, DIRECTION_EAST, id + 1, DIRECTION_WEST, GlobalParams::interposer_link_length, false,
+				  GlobalParams::interposer_link_latency, GlobalParams::interposer_link_width, true);
+	    }
+
+    for (int j = ch - 1; j < dimy - 1; j += ch)
+	for (int i = 0; i < dimx; i += cw)
+	    for (unsigned int k = 0; k < columns.size(); k++)
+	    {
+		int id = j * dimx + i + columns[k];
+		graph->addChannel(id, DIRECTION_SOUTH, id + dimx, DIRECTION_NORTH, GlobalParams::interposer_link_length, false,
+				  GlobalParams::interposer_link_latency, GlobalParams::interposer_link_width, true);
+	    }
+}
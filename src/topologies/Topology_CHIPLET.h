@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_CHIPLET_H__
+#define __NOXIMTOPOLOGY_CHIPLET_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_CHIPLET : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_CHIPLET * getInstance();
+
+	private:
+		Topology_CHIPLET(){};
+		~Topology_CHIPLET(){};
+
+		static Topology_CHIPLET * topology_CHIPLET;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#include "Topology_CMESH.h"
+
+TopologiesRegister Topology_CMESH::topologiesRegister(TOPOLOGY_CMESH, getInstance());
+
+Topology_CMESH * Topology_CMESH::topology_CMESH = 0;
+
+Topology_CMESH * Topology_CMESH::getInstance() {
+	if ( topology_CMESH == 0 )
+		topology_CMESH = new Topology_CMESH();
+    
+	return topology_CMESH;
+}
+
+void Topology_CMESH::build(TopologyGraph * graph)
+{
+    // Same routers and links of the mesh, with several cores each
+    Topologies::get(TOPOLOGY_MESH)->build(graph);
+
+    int routers = GlobalParams::mesh_dim_x * GlobalParams::mesh_dim_y;
+
+    for (int id = 0; id < routers; id++)
+	for (int k = 0; k < GlobalParams::concentration; k++)
+	    graph->addCore(id * GlobalParams::concentration + k, id);
+}
@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_CMESH_H__
+#define __NOXIMTOPOLOGY_CMESH_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_CMESH : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_CMESH * getInstance();
+
+	private:
+		Topology_CMESH(){};
+		~Topology_CMESH(){};
+
+		static Topology_CMESH * topology_CMESH;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
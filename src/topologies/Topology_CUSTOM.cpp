@@ -0,0 +1,70 @@
+#include "Topology_CUSTOM.h"
+#include "yaml-cpp/yaml.h"
+
+TopologiesRegister Topology_CUSTOM::topologiesRegister(TOPOLOGY_CUSTOM, getInstance());
+
+Topology_CUSTOM * Topology_CUSTOM::topology_CUSTOM = 0;
+
+Topology_CUSTOM * Topology_CUSTOM::getInstance() {
+	if ( topology_CUSTOM == 0 )
+		topology_CUSTOM = new Topology_CUSTOM();
+    
+	return topology_CUSTOM;
+}
+
+void Topology_CUSTOM::build(TopologyGraph * graph)
+{
+    YAML::Node topology;
+
+    try {
+	topology = YAML::LoadFile(GlobalParams::topology_filename);
+    } catch (YAML::Exception & e) {
+	cerr << "Error: cannot load topology file " << GlobalParams::topology_filename
+	     << ": " << e.what() << endl;
+	exit(1);
+    }
+
+    const YAML::Node nodes = topology["nodes"];
+    for (YAML::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+	const YAML::Node & n = *it;
+	int id = n["id"].as<int>();
+	bool switch_only = n["switch"] ? n["switch"].as<bool>() : false;
+
+	Coord coord;
+	coord.x = n["x"] ? n["x"].as<int>() : NOT_VALID;
+	coord.y = n["y"] ? n["y"].as<int>() : NOT_VALID;
+	coord.z = n["z"] ? n["z"].as<int>() : 0;
+
+	char tile_name[64];
+	sprintf(tile_name, "%s_(#%d)", switch_only ? "Switch" : "Tile", id);
+	graph->addNode(id, coord, switch_only, tile_name);
+
+	if (n["buffers"])
+	    graph->setDamq(id, n["buffers"].as<string>() == BUFFER_ORGANIZATION_DAMQ);
+
+	// Optional list of the core ids attached to the node
+	if (n["cores"])
+	    for (YAML::const_iterator c = n["cores"].begin(); c != n["cores"].end(); ++c)
+		graph->addCore(c->as<int>(), id);
+    }
+
+    const YAML::Node links = topology["links"];
+    for (YAML::const_iterator it = links.begin(); it != links.end(); ++it)
+    {
+	const YAML::Node & l = *it;
+	double length = l["length"] ? l["length"].as<double>() : GlobalParams::r2r_link_length;
+	bool bidirectional = l["bidirectional"] ? l["bidirectional"].as<bool>() : true;
+	bool dateline = l["dateline"] ? l["dateline"].as<bool>() : false;
+	int latency = l["latency"] ? l["latency"].as<int>() : 0;
+	int width = l["width"] ? l["width"].as<int>() : 0;
+	bool boundary = l["boundary"] ? l["boundary"].as<bool>() : false;
+
+	if (bidirectional)
+	    graph->addChannel(l["src"].as<int>(), l["src_port"].as<int>(),
+			      l["dst"].as<int>(), l["dst_port"].as<int>(), length, dateline, latency, width, boundary);
+	else
+	    graph->addLink(l["src"].as<int>(), l["src_port"].as<int>(),
+			   l["dst"].as<int>(), l["dst_port"].as<int>(), length, dateline, latency, width, boundary);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef __NOXIMTOPOLOGY_CUSTOM_H__
+#define __NOXIMTOPOLOGY_CUSTOM_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+// Topology described by a YAML file (GlobalParams::topology_filename)
+// listing nodes and links, e.g.:
+//
+//   nodes:
+//     - {id: 0, x: 0, y: 0}
+//     - {id: 2, switch: true}
+//   links:
+//     - {src: 0, src_port: 1, dst: 2, dst_port: 3}
+//     - {src: 2, src_port: 0, dst: 1, dst_port: 2, length: 2.0, bidirectional: false}
+//
+// Links are bidirectional by default. Nodes with a PE must have the
+// lowest ids.
+class Topology_CUSTOM : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_CUSTOM * getInstance();
+
+	private:
+		Topology_CUSTOM(){};
+		~Topology_CUSTOM(){};
+
+		static Topology_CUSTOM * topology_CUSTOM;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
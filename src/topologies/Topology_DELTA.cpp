@@ -0,0 +1,75 @@
+#include "Topology_DELTA.h"
+#include "../Utils.h"
+
+int Topology_DELTA::power(const int i)
+{
+    int p = 1;
+
+    for (int j = 0; j < i; j++)
+	p *= GlobalParams::delta_radix;
+
+    return p;
+}
+
+int Topology_DELTA::digit(const int line, const int i)
+{
+    return (line / power(i)) % GlobalParams::delta_radix;
+}
+
+int Topology_DELTA::setDigit(const int line, const int i, const int d)
+{
+    return line + (d - digit(line, i)) * power(i);
+}
+
+void Topology_DELTA::build(TopologyGraph * graph)
+{
+    int n = GlobalParams::n_delta_tiles;
+    int k = GlobalParams::delta_radix;
+    int stg = deltaStages();
+    int sw = deltaSwitches();	// switches per stage
+    double length = GlobalParams::r2r_link_length;
+
+    // Switches
+    for (int j = 0; j < sw; j++)
+	for (int i = 0; i < stg; i++)
+	{
+	    char tile_name[64];
+	    Coord tile_coord;
+	    tile_coord.x = i;
+	    tile_coord.y = j;
+	    int tile_id = n + i * sw + j;
+	    sprintf(tile_name, "Switch[%d][%d]_(#%d)", i, j, tile_id);
+	    graph->addNode(tile_id, tile_coord, true, tile_name);
+	}
+
+    // Cores
+    for (int c = 0; c < n; c++)
+    {
+	char core_name[20];
+	Coord core_coord;
+	core_coord.x = NOT_VALID;
+	core_coord.y = NOT_VALID;
+	sprintf(core_name, "Core_(#%d)", c);
+	graph->addNode(c, core_coord, false, core_name);
+    }
+
+    // Cores to first stage
+    for (int c = 0; c < n; c++)
+	graph->addLink(c, 0, n + c / k, deltaInputPort(c % k), length);
+
+    // Inter-stage links
+    for (int i = 0; i < stg - 1; i++)
+	for (int j = 0; j < sw; j++)
+	    for (int d = 0; d < k; d++)
+	    {
+		int line = permutation(k * j + d, i, stg);
+		graph->addLink(n + i * sw + j, deltaOutputPort(d),
+			       n + (i + 1) * sw + line / k, deltaInputPort(line % k),
+			       length);
+	    }
+
+    // Last stage to cores
+    for (int j = 0; j < sw; j++)
+	for (int d = 0; d < k; d++)
+	    graph->addLink(n + (stg - 1) * sw + j, deltaOutputPort(d), k * j + d, 1, length);
+}
@@ -0,0 +1,29 @@
+#ifndef __NOXIMTOPOLOGY_DELTA_H__
+#define __NOXIMTOPOLOGY_DELTA_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+// Common structure of the radix-k delta networks (k-ary n-flies): k^n
+// cores (ids 0..k^n-1) and n stages of k^(n-1) switches (ids k^n +
+// stage*k^(n-1) + row). Switch output d drives line k*row+d, which
+// enters the next stage through the input of its last base-k digit
+// (see deltaOutputPort and deltaInputPort). Cores inject on port 0 and
+// eject on port 1.
+class Topology_DELTA : public Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+	protected:
+		// Returns the line of the input of stage+1 fed by line of stage
+		virtual int permutation(const int line, const int stage, const int stages) = 0;
+
+		// Base-k digits of a line
+		static int digit(const int line, const int i);
+		static int setDigit(const int line, const int i, const int d);
+		static int power(const int i);
+};
+
+#endif
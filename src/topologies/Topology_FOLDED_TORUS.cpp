@@ -0,0 +1,60 @@
+#include "Topology_FOLDED_TORUS.h"
+
+TopologiesRegister Topology_FOLDED_TORUS::topologiesRegister(TOPOLOGY_FOLDED_TORUS, getInstance());
+
+Topology_FOLDED_TORUS * Topology_FOLDED_TORUS::topology_FOLDED_TORUS = 0;
+
+Topology_FOLDED_TORUS * Topology_FOLDED_TORUS::getInstance() {
+	if ( topology_FOLDED_TORUS == 0 )
+		topology_FOLDED_TORUS = new Topology_FOLDED_TORUS();
+    
+	return topology_FOLDED_TORUS;
+}
+
+// Physical slot of the i-th router of a folded ring of k routers:
+// the first half takes the even slots, the second half the odd ones
+// in reverse order, so that logical neighbours are at most 2 slots away
+int Topology_FOLDED_TORUS::foldedPosition(int i, int k)
+{
+    if (i < (k + 1) / 2)
+	return 2 * i;
+
+    return 2 * (k - 1 - i) + 1;
+}
+
+double Topology_FOLDED_TORUS::linkLength(int i, int j, int k)
+{
+    return abs(foldedPosition(i, k) - foldedPosition(j, k)) * GlobalParams::r2r_link_length;
+}
+
+void Topology_FOLDED_TORUS::build(TopologyGraph * graph)
+{
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+
+    // Tiles keep their logical coordinates, only link lengths change
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    char tile_name[64];
+	    Coord tile_coord;
+	    tile_coord.x = i;
+	    tile_coord.y = j;
+	    int tile_id = j * dimx + i;
+	    sprintf(tile_name, "Tile[%02d][%02d]_(#%d)", i, j, tile_id);
+	    graph->addNode(tile_id, tile_coord, false, tile_name);
+	}
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    int id = j * dimx + i;
+	    int east = (i + 1) % dimx;
+	    int south = (j + 1) % dimy;
+
+	    graph->addChannel(id, DIRECTION_EAST, j * dimx + east, DIRECTION_WEST,
+			      linkLength(i, east, dimx), east == 0);
+	    graph->addChannel(id, DIRECTION_SOUTH, south * dimx + i, DIRECTION_NORTH,
+			      linkLength(j, south, dimy), south == 0);
+	}
+}
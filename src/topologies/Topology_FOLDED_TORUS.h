@@ -0,0 +1,26 @@
+#ifndef __NOXIMTOPOLOGY_FOLDED_TORUS_H__
+#define __NOXIMTOPOLOGY_FOLDED_TORUS_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_FOLDED_TORUS : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_FOLDED_TORUS * getInstance();
+
+		static int foldedPosition(int i, int k);
+		static double linkLength(int i, int j, int k);
+
+	private:
+		Topology_FOLDED_TORUS(){};
+		~Topology_FOLDED_TORUS(){};
+
+		static Topology_FOLDED_TORUS * topology_FOLDED_TORUS;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
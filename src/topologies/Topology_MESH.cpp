@@ -0,0 +1,61 @@
+#include "Topology_MESH.h"
+
+TopologiesRegister Topology_MESH::topologiesRegister(TOPOLOGY_MESH, getInstance());
+
+Topology_MESH * Topology_MESH::topology_MESH = 0;
+
+Topology_MESH * Topology_MESH::getInstance() {
+	if ( topology_MESH == 0 )
+		topology_MESH = new Topology_MESH();
+    
+	return topology_MESH;
+}
+
+void Topology_MESH::build(TopologyGraph * graph)
+{
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    char tile_name[64];
+	    Coord tile_coord;
+	    tile_coord.x = i;
+	    tile_coord.y = j;
+	    int tile_id = j * dimx + i;
+	    sprintf(tile_name, "Tile[%02d][%02d]_(#%d)", i, j, tile_id);
+	    graph->addNode(tile_id, tile_coord, false, tile_name);
+	}
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    int id = j * dimx + i;
+
+	    if (i < dimx - 1)
+		graph->addChannel(id, DIRECTION_EAST, id + 1, DIRECTION_WEST, GlobalParams::r2r_link_length);
+	    if (j < dimy - 1)
+		graph->addChannel(id, DIRECTION_SOUTH, id + dimx, DIRECTION_NORTH, GlobalParams::r2r_link_length);
+	}
+
+    // Express channels connect every k-th router of each row and column
+    // to the router k hops away
+    int k = GlobalParams::express_interval;
+
+    if (k == 0)
+	return;
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    int id = j * dimx + i;
+
+	    if (i % k == 0 && i + k < dimx)
+		graph->addChannel(id, DIRECTION_EXPRESS(DIRECTION_EAST), id + k, DIRECTION_EXPRESS(DIRECTION_WEST),
+				  k * GlobalParams::r2r_link_length);
+	    if (j % k == 0 && j + k < dimy)
+		graph->addChannel(id, DIRECTION_EXPRESS(DIRECTION_SOUTH), id + k * dimx, DIRECTION_EXPRESS(DIRECTION_NORTH),
+				  k * GlobalParams::r2r_link_length);
+	}
+}
@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_MESH_H__
+#define __NOXIMTOPOLOGY_MESH_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_MESH : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_MESH * getInstance();
+
+	private:
+		Topology_MESH(){};
+		~Topology_MESH(){};
+
+		static Topology_MESH * topology_MESH;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "Topology_MESH3D.h"
+
+TopologiesRegister Topology_MESH3D::topologiesRegister(TOPOLOGY_MESH3D, getInstance());
+
+Topology_MESH3D * Topology_MESH3D::topology_MESH3D = 0;
+
+Topology_MESH3D * Topology_MESH3D::getInstance() {
+	if ( topology_MESH3D == 0 )
+		topology_MESH3D = new Topology_MESH3D();
+    
+	return topology_MESH3D;
+}
+
+// mesh_dim_z layers of mesh_dim_x * mesh_dim_y meshes, with each router
+// connected to the ones above and below it by vertical (TSV) links
+void Topology_MESH3D::build(TopologyGraph * graph)
+{
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+    int dimz = GlobalParams::mesh_dim_z;
+
+    for (int k = 0; k < dimz; k++)
+	for (int j = 0; j < dimy; j++)
+	    for (int i = 0; i < dimx; i++)
+	    {
+		char tile_name[64];
+		Coord tile_coord;
+		tile_coord.x = i;
+		tile_coord.y = j;
+		tile_coord.z = k;
+		int tile_id = (k * dimy + j) * dimx + i;
+		sprintf(tile_name, "Tile[%02d][%02d][%02d]_(#%d)", i, j, k, tile_id);
+		graph->addNode(tile_id, tile_coord, false, tile_name);
+	    }
+
+    for (int k = 0; k < dimz; k++)
+	for (int j = 0; j < dimy; j++)
+	    for (int i = 0; i < dimx; i++)
+	    {
+		int id = (k * dimy + j) * dimx + i;
+
+		if (i < dimx - 1)
+		    graph->addChannel(id, DIRECTION_EAST, id + 1, DIRECTION_WEST, GlobalParams::r2r_link_length);
+		if (j < dimy - 1)
+		    graph->addChannel(id, DIRECTION_SOUTH, id + dimx, DIRECTION_NORTH, GlobalParams::r2r_link_length);
+		if (k < dimz - 1)
+		    graph->addChannel(id, DIRECTION_UP, id + dimx * dimy, DIRECTION_DOWN,
+				      GlobalParams::vertical_link_length, false, GlobalParams::vertical_link_latency);
+	    }
+}
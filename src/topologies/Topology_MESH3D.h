@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_MESH3D_H__
+#define __NOXIMTOPOLOGY_MESH3D_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_MESH3D : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_MESH3D * getInstance();
+
+	private:
+		Topology_MESH3D(){};
+		~Topology_MESH3D(){};
+
+		static Topology_MESH3D * topology_MESH3D;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
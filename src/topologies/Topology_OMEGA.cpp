@@ -0,0 +1,19 @@
+#include "Topology_OMEGA.h"
+
+TopologiesRegister Topology_OMEGA::topologiesRegister(TOPOLOGY_OMEGA, getInstance());
+
+Topology_OMEGA * Topology_OMEGA::topology_OMEGA = 0;
+
+Topology_OMEGA * Topology_OMEGA::getInstance() {
+	if ( topology_OMEGA == 0 )
+		topology_OMEGA = new Topology_OMEGA();
+    
+	return topology_OMEGA;
+}
+
+// Perfect k-shuffle: rotate left the line by one digit over all the
+// stages digits
+int Topology_OMEGA::permutation(const int line, const int stage, const int stages)
+{
+    return (line % power(stages - 1)) * GlobalParams::delta_radix + digit(line, stages - 1);
+}
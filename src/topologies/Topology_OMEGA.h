@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_OMEGA_H__
+#define __NOXIMTOPOLOGY_OMEGA_H__
+
+#include "Topology_DELTA.h"
+
+using namespace std;
+
+class Topology_OMEGA : Topology_DELTA {
+	public:
+		static Topology_OMEGA * getInstance();
+
+	protected:
+		int permutation(const int line, const int stage, const int stages);
+
+	private:
+		Topology_OMEGA(){};
+		~Topology_OMEGA(){};
+
+		static Topology_OMEGA * topology_OMEGA;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif
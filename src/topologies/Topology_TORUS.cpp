@@ -0,0 +1,49 @@
+#include "Topology_TORUS.h"
+
+TopologiesRegister Topology_TORUS::topologiesRegister(TOPOLOGY_TORUS, getInstance());
+
+Topology_TORUS * Topology_TORUS::topology_TORUS = 0;
+
+Topology_TORUS * Topology_TORUS::getInstance() {
+	if ( topology_TORUS == 0 )
+		topology_TORUS = new Topology_TORUS();
+    
+	return topology_TORUS;
+}
+
+void Topology_TORUS::build(TopologyGraph * graph)
+{
+    int dimx = GlobalParams::mesh_dim_x;
+    int dimy = GlobalParams::mesh_dim_y;
+
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    char tile_name[64];
+	    Coord tile_coord;
+	    tile_coord.x = i;
+	    tile_coord.y = j;
+	    int tile_id = j * dimx + i;
+	    sprintf(tile_name, "Tile[%02d][%02d]_(#%d)", i, j, tile_id);
+	    graph->addNode(tile_id, tile_coord, false, tile_name);
+	}
+
+    // Wraparound links span the whole row/column and are the datelines
+    for (int j = 0; j < dimy; j++)
+	for (int i = 0; i < dimx; i++)
+	{
+	    int id = j * dimx + i;
+
+	    if (i < dimx - 1)
+		graph->addChannel(id, DIRECTION_EAST, id + 1, DIRECTION_WEST, GlobalParams::r2r_link_length);
+	    else
+		graph->addChannel(id, DIRECTION_EAST, j * dimx, DIRECTION_WEST,
+				  (dimx - 1) * GlobalParams::r2r_link_length, true);
+
+	    if (j < dimy - 1)
+		graph->addChannel(id, DIRECTION_SOUTH, id + dimx, DIRECTION_NORTH, GlobalParams::r2r_link_length);
+	    else
+		graph->addChannel(id, DIRECTION_SOUTH, i, DIRECTION_NORTH,
+				  (dimy - 1) * GlobalParams::r2r_link_length, true);
+	}
+}
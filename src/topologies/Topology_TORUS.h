@@ -0,0 +1,23 @@
+#ifndef __NOXIMTOPOLOGY_TORUS_H__
+#define __NOXIMTOPOLOGY_TORUS_H__
+
+#include "Topology.h"
+#include "Topologies.h"
+
+using namespace std;
+
+class Topology_TORUS : Topology {
+	public:
+		void build(TopologyGraph * graph);
+
+		static Topology_TORUS * getInstance();
+
+	private:
+		Topology_TORUS(){};
+		~Topology_TORUS(){};
+
+		static Topology_TORUS * topology_TORUS;
+		static TopologiesRegister topologiesRegister;
+};
+
+#endif